@@ -9,6 +9,7 @@
 
 #include <iostream>
 #include <locale>
+#include <cwctype>
 #include "modAlphaCipher.h"
 
 using namespace std;
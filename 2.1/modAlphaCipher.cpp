@@ -8,41 +8,65 @@
  */
 
 #include "modAlphaCipher.h"
-#include <cctype>
 #include <algorithm>
-#include <cwctype>  /// Для wide character функций
+#include "../common/modParallel.h"
 
 /**
  * @brief Конструктор класса modAlphaCipher
  * @param [in] skey Ключ шифрования
+ * @param [in] how Способ сдвига букв по ключу
  * @throw cipher_error Если ключ невалиден
- * @details Инициализирует алфавит и преобразует ключ в числовой вектор
+ * @details Проверяет ключ и берет подготовленный ключ из общего кэша
  */
-modAlphaCipher::modAlphaCipher(const std::wstring& skey) {
-    // Инициализация ассоциативного массива "символ-номер"
-    for (size_t i = 0; i < numAlpha.size(); ++i) {
-        alphaNum[numAlpha[i]] = static_cast<int>(i);
-    }
-    // Валидация и преобразование ключа
-    key = convert(getValidKey(skey));
+modAlphaCipher::modAlphaCipher(const std::wstring& skey, shift_strategy how) : strategy(how) {
+    rekey(skey);
 }
 
 /**
- * @brief Преобразование символа в верхний регистр для русского алфавита
- * @param [in] c Символ для преобразования
- * @return Символ в верхнем регистре
+ * @brief Смена ключа без создания нового шифратора
+ * @param [in] skey Новый ключ шифрования
+ * @throw cipher_error Если ключ невалиден
  */
-wchar_t modAlphaCipher::toUpper(wchar_t c) {
-    // Обработка русских строчных букв
-    if (c >= L'а' && c <= L'я') {
-        return L'А' + (c - L'а');
-    }
-    // Обработка буквы "ё"
-    if (c == L'ё') {
-        return L'Ё';
+void modAlphaCipher::rekey(const std::wstring& skey) {
+    schedule = scheduleCache().get(getValidKey(skey));
+    // Без векторного ядра одно чтение из таблицы дешевле сложения с вычитанием
+    bool preferTable = strategy == shift_strategy::table ||
+                       (strategy == shift_strategy::automatic && !shiftKernelVectorized());
+    useTable = preferTable && !schedule->encTable.empty();
+}
+
+/**
+ * @brief Сдвиг блока номеров букв выбранным способом
+ * @param [in,out] work Номера букв 0..32
+ * @param [in] m Количество номеров
+ * @param [in] inverse Обратный сдвиг для дешифрования
+ * @param [in] phase Позиция в ключе для work[0]
+ * @return Позиция в ключе для следующей буквы
+ */
+size_t modAlphaCipher::shiftBlock(uint8_t* work, size_t m, bool inverse, size_t phase) const noexcept {
+    const size_t keySize = schedule->key.size();
+    if (useTable) {
+        return shiftTable(work, m, (inverse ? schedule->decTable : schedule->encTable).data(), keySize, phase);
     }
-    // Стандартное преобразование для других символов
-    return std::towupper(c);
+    return shiftIndices(work, m, (inverse ? schedule->decStream : schedule->encStream).data(), keySize, phase);
+}
+
+/**
+ * @brief Счетчики шифра Гронсфельда
+ * @return Общие для всех шифраторов счетчики
+ */
+CipherStats& modAlphaCipher::stats() noexcept {
+    static CipherStats counters;
+    return counters;
+}
+
+/**
+ * @brief Общий кэш подготовленных ключей
+ * @return Кэш емкостью scheduleCacheSize и scheduleCacheBytes
+ */
+KeyScheduleCache& modAlphaCipher::scheduleCache() {
+    static KeyScheduleCache cache(scheduleCacheSize, scheduleCacheBytes, scheduleEntryBytes);
+    return cache;
 }
 
 /**
@@ -52,133 +76,641 @@ wchar_t modAlphaCipher::toUpper(wchar_t c) {
  * @throw cipher_error Если ключ пустой или содержит не-буквенные символы
  */
 std::wstring modAlphaCipher::getValidKey(const std::wstring& s) {
-    // Проверка на пустой ключ
-    if (s.empty()) {
-        throw cipher_error("Empty key");
+    if (!checkKey(s)) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::invalid_key);
+        throwCipherError(s.empty() ? "Empty key" : "Invalid key: non-alphabetic character");
     }
     std::wstring tmp(s);
-    // Проверка каждого символа ключа
+    // Приведение ключа к верхнему регистру
     for (auto& c : tmp) {
-        if (!std::iswalpha(c)) {
-            throw cipher_error("Invalid key: non-alphabetic character");
-        }
-        // Преобразование строчных букв в прописные
-        if (std::iswlower(c)) {
-            c = toUpper(c);
-        }
+        c = Alphabet::toUpper(c);
     }
     return tmp;
 }
 
 /**
- * @brief Валидация открытого текста
- * @param [in] s Текст для проверки
- * @return Валидный текст только с буквами в верхнем регистре
- * @throw cipher_error Если текст не содержит букв после очистки
+ * @brief Проверка ключа без исключений
+ * @param [in] s Ключ для проверки
+ * @return cipher_status::invalid_key и позиция первого не-буквенного символа
+ * (0 для пустого ключа) или успешный результат
  */
-std::wstring modAlphaCipher::getValidOpenText(const std::wstring& s) {
-    std::wstring tmp;
-    // Фильтрация текста: оставляем только буквы
-    for (auto c : s) {
-        if (std::iswalpha(c)) {
-            // Преобразование строчных букв в прописные
-            if (std::iswlower(c)) {
-                tmp.push_back(toUpper(c));
-            } else {
-                tmp.push_back(c);
-            }
+cipher_result modAlphaCipher::checkKey(std::wstring_view s) noexcept {
+    if (s.empty()) {
+        return {cipher_status::invalid_key, 0};
+    }
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (Alphabet::index(s[i]) < 0) {
+            return {cipher_status::invalid_key, i};
         }
     }
+    return {};
+}
+
+/**
+ * @brief Шифрование открытого текста
+ * @param [in] open_text Открытый текст для шифрования
+ * @return Зашифрованный текст
+ * @throw cipher_error Если текст невалиден
+ */
+std::wstring modAlphaCipher::encrypt(const std::wstring& open_text) const {
+    // Результат не длиннее исходного текста
+    std::wstring result(open_text.size(), L'\0');
+    result.resize(encryptInto(open_text, &result[0], result.size()));
+    return result;
+}
+
+/**
+ * @brief Дешифрование зашифрованного текста
+ * @param [in] cipher_text Зашифрованный текст для дешифрования
+ * @return Расшифрованный текст
+ * @throw cipher_error Если текст невалиден
+ */
+std::wstring modAlphaCipher::decrypt(const std::wstring& cipher_text) const {
+    std::wstring result(cipher_text.size(), L'\0');
+    result.resize(decryptInto(cipher_text, &result[0], result.size()));
+    return result;
+}
+
+/**
+ * @brief Шифрование открытого текста с результатом из заданного источника памяти
+ * @param [in] open_text Открытый текст для шифрования
+ * @param [in] mr Источник памяти для результата
+ * @return Зашифрованный текст
+ * @throw cipher_error Если текст не содержит букв
+ */
+std::pmr::wstring modAlphaCipher::encrypt(std::wstring_view open_text, std::pmr::memory_resource* mr) const {
+    std::pmr::wstring result(open_text.size(), L'\0', mr);
+    size_t phase = 0;
+    size_t n = encryptChunk(open_text.data(), open_text.size(), &result[0], result.size(), phase);
+    if (n == 0) {
+        throwCipherError("Empty text, no letters");
+    }
+    result.resize(n);
+    return result;
+}
+
+/**
+ * @brief Дешифрование зашифрованного текста с результатом из заданного источника памяти
+ * @param [in] cipher_text Зашифрованный текст для дешифрования
+ * @param [in] mr Источник памяти для результата
+ * @return Расшифрованный текст
+ * @throw cipher_error Если текст невалиден
+ */
+std::pmr::wstring modAlphaCipher::decrypt(std::wstring_view cipher_text, std::pmr::memory_resource* mr) const {
+    if (cipher_text.empty()) {
+        throwCipherError("Empty cipher text");
+    }
+    std::pmr::wstring result(cipher_text.size(), L'\0', mr);
+    size_t phase = 0;
+    decryptChunk(cipher_text.data(), cipher_text.size(), &result[0], result.size(), phase);
+    return result;
+}
+
+/**
+ * @brief Сдвиг текста из номеров букв по ключевому потоку
+ * @details Блок копируется и сразу сдвигается, пока находится в кэше
+ * @param [in] text Исходный текст
+ * @param [in] inverse Обратный сдвиг для дешифрования
+ * @return Сдвинутый текст
+ */
+IndexedText modAlphaCipher::shiftText(const IndexedText& text, bool inverse) const {
+    const size_t n = text.size();
+    IndexedText result(n);
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        size_t phase = 0;
+        for (size_t start = 0; start < n; start += blockSize) {
+            size_t m = std::min(blockSize, n - start);
+            std::copy_n(text.data() + start, m, result.idx.data() + start);
+            phase = shiftBlock(result.idx.data() + start, m, inverse, phase);
+        }
+    }
+    CIPHER_STATS_INPUT(stats(), n, n);
+    CIPHER_STATS_OUTPUT(stats(), n);
+    return result;
+}
+
+/**
+ * @brief Шифрование текста из номеров букв
+ * @param [in] open_text Открытый текст
+ * @return Зашифрованный текст
+ * @throw cipher_error Если текст пустой
+ */
+IndexedText modAlphaCipher::encrypt(const IndexedText& open_text) const {
+    if (open_text.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty text, no letters");
+    }
+    return shiftText(open_text, false);
+}
+
+/**
+ * @brief Дешифрование текста из номеров букв
+ * @param [in] cipher_text Зашифрованный текст
+ * @return Расшифрованный текст
+ * @throw cipher_error Если текст пустой
+ */
+IndexedText modAlphaCipher::decrypt(const IndexedText& cipher_text) const {
+    if (cipher_text.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty cipher text");
+    }
+    return shiftText(cipher_text, true);
+}
+
+/**
+ * @brief Шифрование открытого текста без исключений
+ * @param [in] open_text Открытый текст для шифрования
+ * @param [out] out Зашифрованный текст (пустой при ошибке)
+ * @return cipher_status::empty_text, если текст не содержит букв
+ */
+cipher_result modAlphaCipher::tryEncrypt(std::wstring_view open_text, std::wstring& out) const {
+    out.resize(open_text.size());
+    size_t phase = 0;
+    // Буфер длиной входа достаточен, поэтому encryptChunk не возбуждает исключений
+    size_t n = encryptChunk(open_text.data(), open_text.size(), &out[0], out.size(), phase);
+    out.resize(n);
+    if (n == 0) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        return {cipher_status::empty_text, 0};
+    }
+    return {};
+}
+
+/**
+ * @brief Дешифрование зашифрованного текста без исключений
+ * @param [in] cipher_text Зашифрованный текст для дешифрования
+ * @param [out] out Расшифрованный текст (пустой при ошибке)
+ * @return cipher_status::empty_text для пустого текста или
+ * cipher_status::invalid_text и позиция первого не-прописного символа
+ */
+cipher_result modAlphaCipher::tryDecrypt(std::wstring_view cipher_text, std::wstring& out) const {
+    if (cipher_text.empty()) {
+        out.clear();
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        return {cipher_status::empty_text, 0};
+    }
+    out.resize(cipher_text.size());
+    size_t phase = 0;
+    size_t pos = decryptBlocks(cipher_text.data(), cipher_text.size(), &out[0], phase);
+    if (pos != cipher_text.size()) {
+        out.clear();
+        return {cipher_status::invalid_text, pos};
+    }
+    return {};
+}
+
+/**
+ * @brief Шифрование открытого текста в буфер вызывающей стороны
+ * @param [in] open_text Открытый текст для шифрования
+ * @param [out] out Буфер для зашифрованного текста
+ * @param [in] capacity Размер буфера в символах
+ * @return Количество записанных символов
+ * @throw cipher_error Если текст не содержит букв или буфер слишком мал
+ */
+size_t modAlphaCipher::encryptInto(const std::wstring& open_text, wchar_t* out, size_t capacity) const {
+    size_t phase = 0;
+    size_t n = encryptChunk(open_text.data(), open_text.size(), out, capacity, phase);
     // Проверка на пустой текст после фильтрации
-    if (tmp.empty()) {
-        throw cipher_error("Empty text, no letters");
+    if (n == 0) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty text, no letters");
     }
-    return tmp;
+    return n;
 }
 
 /**
- * @brief Валидация зашифрованного текста
- * @param [in] s Зашифрованный текст для проверки
- * @return Валидный зашифрованный текст
- * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+ * @brief Дешифрование зашифрованного текста в буфер вызывающей стороны
+ * @param [in] cipher_text Зашифрованный текст для дешифрования
+ * @param [out] out Буфер для расшифрованного текста
+ * @param [in] capacity Размер буфера в символах
+ * @return Количество записанных символов
+ * @throw cipher_error Если текст невалиден или буфер слишком мал
  */
-std::wstring modAlphaCipher::getValidCipherText(const std::wstring& s) {
+size_t modAlphaCipher::decryptInto(const std::wstring& cipher_text, wchar_t* out, size_t capacity) const {
     // Проверка на пустой зашифрованный текст
-    if (s.empty()) {
-        throw cipher_error("Empty cipher text");
+    if (cipher_text.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty cipher text");
     }
-    // Проверка что все символы - прописные буквы
-    for (auto c : s) {
-        if (!std::iswupper(c)) {
-            throw cipher_error("Incorrect data entry");
+    size_t phase = 0;
+    return decryptChunk(cipher_text.data(), cipher_text.size(), out, capacity, phase);
+}
+
+/**
+ * @brief Шифрование фрагмента текста с заданной фазы ключа
+ * @param [in] in Фрагмент открытого текста
+ * @param [in] len Длина фрагмента
+ * @param [out] out Буфер для зашифрованного текста
+ * @param [in] capacity Размер буфера в символах
+ * @param [in,out] phase Позиция в ключе
+ * @return Количество записанных символов
+ * @throw cipher_error Если буфер слишком мал
+ */
+size_t modAlphaCipher::encryptChunk(const wchar_t* in, size_t len, wchar_t* out, size_t capacity, size_t& phase) const {
+    uint8_t work[blockSize];
+    size_t pos = 0;
+    size_t n = 0;
+    while (pos < len) {
+        // Фильтрация и преобразование блока в номера букв
+        size_t m;
+        {
+            CIPHER_STATS_TIMER(stats(), cipher_stage::validate);
+            size_t step = std::min(blockSize, len - pos);
+            m = Normalize::indices(in + pos, step, work);
+            pos += step;
+        }
+        if (m > capacity - n) {
+            throwCipherError("Output buffer too small");
+        }
+        // Сдвиг блока и запись результата
+        {
+            CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+            phase = shiftBlock(work, m, false, phase);
+        }
+        {
+            CIPHER_STATS_TIMER(stats(), cipher_stage::emit);
+            for (size_t j = 0; j < m; ++j) {
+                out[n + j] = Alphabet::letter(work[j]);
+            }
         }
+        n += m;
     }
-    return s;
+    CIPHER_STATS_INPUT(stats(), len, n);
+    CIPHER_STATS_OUTPUT(stats(), n);
+    return n;
 }
 
 /**
- * @brief Преобразование строки в числовой вектор
- * @param [in] s Строка для преобразования
- * @return Вектор числовых представлений символов
+ * @brief Дешифрование фрагмента текста с заданной фазы ключа
+ * @param [in] in Фрагмент зашифрованного текста
+ * @param [in] len Длина фрагмента
+ * @param [out] out Буфер для расшифрованного текста
+ * @param [in] capacity Размер буфера в символах
+ * @param [in,out] phase Позиция в ключе
+ * @return Количество записанных символов
+ * @throw cipher_error Если фрагмент невалиден или буфер слишком мал
  */
-std::vector<int> modAlphaCipher::convert(const std::wstring& s) {
-    std::vector<int> result;
-    // Преобразование каждого символа в его числовое представление
-    for (auto c : s) {
-        wchar_t upperC = toUpper(c);
-        if (alphaNum.find(upperC) != alphaNum.end()) {
-            result.push_back(alphaNum[upperC]);
+size_t modAlphaCipher::decryptChunk(const wchar_t* in, size_t len, wchar_t* out, size_t capacity, size_t& phase) const {
+    if (len > capacity) {
+        throwCipherError("Output buffer too small");
+    }
+    if (decryptBlocks(in, len, out, phase) != len) {
+        throwCipherError("Incorrect data entry");
+    }
+    return len;
+}
+
+/**
+ * @brief Дешифрование фрагмента текста без исключений
+ * @param [in] in Фрагмент зашифрованного текста
+ * @param [in] len Длина фрагмента
+ * @param [out] out Буфер для расшифрованного текста длиной не менее len
+ * @param [in,out] phase Позиция в ключе
+ * @return len при успехе или позиция первого не-прописного символа
+ */
+size_t modAlphaCipher::decryptBlocks(const wchar_t* in, size_t len, wchar_t* out, size_t& phase) const noexcept {
+    uint8_t work[blockSize];
+    for (size_t n = 0; n < len; n += blockSize) {
+        size_t m = std::min(blockSize, len - n);
+        // Векторная проверка блока сразу дает позицию ошибки
+        size_t valid;
+        {
+            CIPHER_STATS_TIMER(stats(), cipher_stage::validate);
+            valid = Normalize::upperIndices(in + n, m, work);
+        }
+        if (valid != m) {
+            CIPHER_STATS_REJECT(stats(), cipher_status::invalid_text);
+            return n + valid;
+        }
+        CIPHER_STATS_INPUT(stats(), m, m);
+        // Обратный сдвиг блока и запись результата
+        {
+            CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+            phase = shiftBlock(work, m, true, phase);
+        }
+        {
+            CIPHER_STATS_TIMER(stats(), cipher_stage::emit);
+            for (size_t j = 0; j < m; ++j) {
+                out[n + j] = Alphabet::letter(work[j]);
+            }
         }
     }
+    CIPHER_STATS_OUTPUT(stats(), len);
+    return len;
+}
+
+/**
+ * @brief Шифрование открытого текста в UTF-8
+ * @param [in] open_text Открытый текст в UTF-8
+ * @return Зашифрованный текст в UTF-8
+ * @throw cipher_error Если текст не содержит букв
+ */
+std::string modAlphaCipher::encrypt(std::string_view open_text) const {
+    // Каждая русская буква занимает два байта на входе и на выходе
+    std::string result(open_text.size(), '\0');
+    result.resize(encryptInto(open_text, &result[0], result.size()));
     return result;
 }
 
 /**
- * @brief Преобразование числового вектора в строку
- * @param [in] v Числовой вектор для преобразования
- * @return Строка, восстановленная из числовых представлений
+ * @brief Дешифрование зашифрованного текста в UTF-8
+ * @param [in] cipher_text Зашифрованный текст в UTF-8
+ * @return Расшифрованный текст в UTF-8
+ * @throw cipher_error Если текст невалиден
  */
-std::wstring modAlphaCipher::convert(const std::vector<int>& v) {
-    std::wstring result;
-    // Преобразование каждого числа обратно в символ
-    for (auto i : v) {
-        if (i >= 0 && i < static_cast<int>(numAlpha.size())) {
-            result.push_back(numAlpha[i]);
-        }
+std::string modAlphaCipher::decrypt(std::string_view cipher_text) const {
+    std::string result(cipher_text.size(), '\0');
+    result.resize(decryptInto(cipher_text, &result[0], result.size()));
+    return result;
+}
+
+/**
+ * @brief Шифрование открытого текста в UTF-8 в буфер вызывающей стороны
+ * @param [in] open_text Открытый текст в UTF-8
+ * @param [out] out Буфер для зашифрованного текста
+ * @param [in] capacity Размер буфера в байтах
+ * @return Количество записанных байтов
+ * @throw cipher_error Если текст не содержит букв или буфер слишком мал
+ */
+size_t modAlphaCipher::encryptInto(std::string_view open_text, char* out, size_t capacity) const {
+    size_t phase = 0;
+    size_t n = encryptChunk(open_text.data(), open_text.size(), out, capacity, phase);
+    if (n == 0) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty text, no letters");
     }
+    return n;
+}
+
+/**
+ * @brief Дешифрование зашифрованного текста в UTF-8 в буфер вызывающей стороны
+ * @param [in] cipher_text Зашифрованный текст в UTF-8
+ * @param [out] out Буфер для расшифрованного текста
+ * @param [in] capacity Размер буфера в байтах
+ * @return Количество записанных байтов
+ * @throw cipher_error Если текст невалиден или буфер слишком мал
+ */
+size_t modAlphaCipher::decryptInto(std::string_view cipher_text, char* out, size_t capacity) const {
+    if (cipher_text.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty cipher text");
+    }
+    size_t phase = 0;
+    return decryptChunk(cipher_text.data(), cipher_text.size(), out, capacity, phase);
+}
+
+/**
+ * @brief Дешифрование участка зашифрованного текста
+ * @param [in] cipher_text Весь зашифрованный текст
+ * @param [in] pos Позиция первой буквы участка
+ * @param [in] len Количество букв участка
+ * @return Расшифрованный участок
+ * @throw cipher_error Если участок выходит за текст или невалиден
+ */
+std::wstring modAlphaCipher::decryptRange(std::wstring_view cipher_text, size_t pos, size_t len) const {
+    if (pos > cipher_text.size() || len > cipher_text.size() - pos) {
+        throwCipherError("Range out of bounds");
+    }
+    std::wstring result(len, L'\0');
+    size_t phase = pos % schedule->key.size();
+    decryptChunk(cipher_text.data() + pos, len, &result[0], len, phase);
     return result;
 }
 
 /**
- * @brief Шифрование открытого текста
+ * @brief Дешифрование участка зашифрованного текста в UTF-8
+ * @param [in] cipher_text Весь зашифрованный текст в UTF-8
+ * @param [in] pos Позиция первой буквы участка
+ * @param [in] len Количество букв участка
+ * @return Расшифрованный участок в UTF-8
+ * @throw cipher_error Если участок выходит за текст или невалиден
+ */
+std::string modAlphaCipher::decryptRange(std::string_view cipher_text, size_t pos, size_t len) const {
+    const size_t letters = cipher_text.size() / 2;
+    if (pos > letters || len > letters - pos) {
+        throwCipherError("Range out of bounds");
+    }
+    std::string result(2 * len, '\0');
+    size_t phase = pos % schedule->key.size();
+    decryptChunk(cipher_text.data() + 2 * pos, 2 * len, &result[0], result.size(), phase);
+    return result;
+}
+
+/**
+ * @brief Шифрование фрагмента текста в UTF-8 с заданной фазы ключа
+ * @param [in] in Фрагмент открытого текста в UTF-8
+ * @param [in] len Длина фрагмента в байтах
+ * @param [out] out Буфер для зашифрованного текста
+ * @param [in] capacity Размер буфера в байтах
+ * @param [in,out] phase Позиция в ключе
+ * @return Количество записанных байтов
+ * @throw cipher_error Если буфер слишком мал
+ */
+size_t modAlphaCipher::encryptChunk(const char* in, size_t len, char* out, size_t capacity, size_t& phase) const {
+    uint8_t work[blockSize];
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(in);
+    const unsigned char* end = p + len;
+    size_t n = 0;
+    while (p < end) {
+        // Разбор UTF-8 и фильтрация блока: ASCII и прочие символы пропускаются
+        size_t m = 0;
+        {
+            CIPHER_STATS_TIMER(stats(), cipher_stage::validate);
+            while (p < end && m < blockSize) {
+                if (*p < 0x80) {
+                    ++p;
+                    continue;
+                }
+                int i = Alphabet::utf8Next(p, end);
+                if (i >= 0) {
+                    work[m++] = static_cast<uint8_t>(i);
+                }
+            }
+        }
+        if (2 * m > capacity - n) {
+            throwCipherError("Output buffer too small");
+        }
+        // Сдвиг блока и запись результата
+        {
+            CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+            phase = shiftBlock(work, m, false, phase);
+        }
+        {
+            CIPHER_STATS_TIMER(stats(), cipher_stage::emit);
+            for (size_t j = 0; j < m; ++j) {
+                Alphabet::utf8Letter(work[j], out + n + 2 * j);
+            }
+        }
+        n += 2 * m;
+    }
+    // Вход и выход учитываются в байтах, как в Table
+    CIPHER_STATS_INPUT(stats(), len, n / 2);
+    CIPHER_STATS_OUTPUT(stats(), n);
+    return n;
+}
+
+/**
+ * @brief Дешифрование фрагмента текста в UTF-8 с заданной фазы ключа
+ * @param [in] in Фрагмент зашифрованного текста в UTF-8
+ * @param [in] len Длина фрагмента в байтах
+ * @param [out] out Буфер для расшифрованного текста
+ * @param [in] capacity Размер буфера в байтах
+ * @param [in,out] phase Позиция в ключе
+ * @return Количество записанных байтов
+ * @throw cipher_error Если фрагмент невалиден или буфер слишком мал
+ */
+size_t modAlphaCipher::decryptChunk(const char* in, size_t len, char* out, size_t capacity, size_t& phase) const {
+    // Шифротекст состоит только из двухбайтовых прописных букв
+    if (len % 2 != 0) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::invalid_text);
+        throwCipherError("Incorrect data entry");
+    }
+    if (len > capacity) {
+        throwCipherError("Output buffer too small");
+    }
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(in);
+    const size_t letters = len / 2;
+    uint8_t work[blockSize];
+    for (size_t n = 0; n < letters; n += blockSize) {
+        size_t m = std::min(blockSize, letters - n);
+        int bad = 0;
+        {
+            CIPHER_STATS_TIMER(stats(), cipher_stage::validate);
+            for (size_t j = 0; j < m; ++j) {
+                int i = Alphabet::utf8UpperIndex(p[2 * (n + j)], p[2 * (n + j) + 1]);
+                bad |= Alphabet::utf8Length(p[2 * (n + j)]) != 2 ? -1 : i;
+                work[j] = static_cast<uint8_t>(i);
+            }
+        }
+        if (bad < 0) {
+            CIPHER_STATS_REJECT(stats(), cipher_status::invalid_text);
+            throwCipherError("Incorrect data entry");
+        }
+        CIPHER_STATS_INPUT(stats(), 2 * m, m);
+        {
+            CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+            phase = shiftBlock(work, m, true, phase);
+        }
+        {
+            CIPHER_STATS_TIMER(stats(), cipher_stage::emit);
+            for (size_t j = 0; j < m; ++j) {
+                Alphabet::utf8Letter(work[j], out + 2 * (n + j));
+            }
+        }
+    }
+    CIPHER_STATS_OUTPUT(stats(), len);
+    return len;
+}
+
+/**
+ * @brief Параллельное шифрование открытого текста
  * @param [in] open_text Открытый текст для шифрования
+ * @param [in] threads Количество потоков (0 - по числу ядер)
  * @return Зашифрованный текст
  * @throw cipher_error Если текст невалиден
  */
-std::wstring modAlphaCipher::encrypt(const std::wstring& open_text) {
-    // Преобразование текста в числовой вектор
-    std::vector<int> work = convert(getValidOpenText(open_text));
-    // Шифрование каждого символа
-    for (size_t i = 0; i < work.size(); ++i) {
-        work[i] = (work[i] + key[i % key.size()]) % numAlpha.size();
+std::wstring modAlphaCipher::encryptParallel(const std::wstring& open_text, unsigned threads) const {
+    threads = parallelThreads(threads);
+    if (threads == 1 || open_text.size() < parallelThreshold) {
+        return encrypt(open_text);
+    }
+    const size_t len = open_text.size();
+    const size_t parts = threads;
+    const size_t step = (len + parts - 1) / parts;
+    // Подсчет букв в каждом участке
+    std::vector<size_t> offset(parts + 1, 0);
+    parallelFor(parts, threads, [&](size_t t) {
+        size_t count = 0;
+        for (size_t i = t * step; i < std::min(len, (t + 1) * step); ++i) {
+            count += Alphabet::index(open_text[i]) >= 0;
+        }
+        offset[t + 1] = count;
+    });
+    // Префиксная сумма дает позицию участка в результате
+    for (size_t t = 0; t < parts; ++t) {
+        offset[t + 1] += offset[t];
+    }
+    if (offset[parts] == 0) {
+        throwCipherError("Empty text, no letters");
     }
-    // Преобразование обратно в строку
-    return convert(work);
+    std::wstring result(offset[parts], L'\0');
+    parallelFor(parts, threads, [&](size_t t) {
+        size_t begin = std::min(len, t * step);
+        size_t end = std::min(len, (t + 1) * step);
+        size_t phase = offset[t] % schedule->key.size();
+        encryptChunk(open_text.data() + begin, end - begin, &result[offset[t]],
+                     offset[t + 1] - offset[t], phase);
+    });
+    return result;
 }
 
 /**
- * @brief Дешифрование зашифрованного текста
+ * @brief Параллельное дешифрование зашифрованного текста
  * @param [in] cipher_text Зашифрованный текст для дешифрования
+ * @param [in] threads Количество потоков (0 - по числу ядер)
  * @return Расшифрованный текст
  * @throw cipher_error Если текст невалиден
  */
-std::wstring modAlphaCipher::decrypt(const std::wstring& cipher_text) {
-    // Преобразование текста в числовой вектор
-    std::vector<int> work = convert(getValidCipherText(cipher_text));
-    // Дешифрование каждого символа
-    for (size_t i = 0; i < work.size(); ++i) {
-        work[i] = (work[i] + numAlpha.size() - key[i % key.size()]) % numAlpha.size();
+std::wstring modAlphaCipher::decryptParallel(const std::wstring& cipher_text, unsigned threads) const {
+    threads = parallelThreads(threads);
+    if (threads == 1 || cipher_text.size() < parallelThreshold) {
+        return decrypt(cipher_text);
+    }
+    const size_t len = cipher_text.size();
+    const size_t parts = threads;
+    const size_t step = (len + parts - 1) / parts;
+    std::wstring result(len, L'\0');
+    // В шифротексте каждый символ - буква, смещение участка известно сразу
+    parallelFor(parts, threads, [&](size_t t) {
+        size_t begin = std::min(len, t * step);
+        size_t end = std::min(len, (t + 1) * step);
+        size_t phase = begin % schedule->key.size();
+        decryptChunk(cipher_text.data() + begin, end - begin, &result[begin], end - begin, phase);
+    });
+    return result;
+}
+
+/**
+ * @brief Пакетное шифрование сообщений
+ * @param [in] texts Открытые тексты
+ * @param [in] count Количество сообщений
+ * @param [out] out Результаты пакета
+ */
+void modAlphaCipher::encryptBatch(const std::wstring_view* texts, size_t count, CipherBatch& out) const {
+    wchar_t* arena = out.prepare(texts, count);
+    for (size_t i = 0; i < count; ++i) {
+        // Буфер длиной входа достаточен, поэтому encryptChunk не возбуждает исключений
+        size_t phase = 0;
+        wchar_t* dst = arena + out.offsets.back();
+        size_t n = encryptChunk(texts[i].data(), texts[i].size(), dst, texts[i].size(), phase);
+        out.push(n == 0 ? cipher_status::empty_text : cipher_status::ok, n);
+    }
+    out.finish();
+}
+
+/**
+ * @brief Пакетное дешифрование сообщений
+ * @param [in] texts Зашифрованные тексты
+ * @param [in] count Количество сообщений
+ * @param [out] out Результаты пакета
+ */
+void modAlphaCipher::decryptBatch(const std::wstring_view* texts, size_t count, CipherBatch& out) const {
+    wchar_t* arena = out.prepare(texts, count);
+    for (size_t i = 0; i < count; ++i) {
+        const std::wstring_view& text = texts[i];
+        if (text.empty()) {
+            out.push(cipher_status::empty_text, 0);
+            continue;
+        }
+        // Проверка до дешифрования, чтобы decryptChunk не возбуждал исключений
+        if (Normalize::findNonUpper(text.data(), text.size()) != text.size()) {
+            out.push(cipher_status::invalid_text, 0);
+            continue;
+        }
+        size_t phase = 0;
+        wchar_t* dst = arena + out.offsets.back();
+        out.push(cipher_status::ok, decryptChunk(text.data(), text.size(), dst, text.size(), phase));
     }
-    // Преобразование обратно в строку
-    return convert(work);
+    out.finish();
 }
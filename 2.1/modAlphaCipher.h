@@ -8,85 +8,146 @@
  */
 
 #pragma once
+#include <memory_resource>
 #include <vector>
 #include <string>
-#include <map>
-#include <stdexcept>
-#include <cwctype>  /// Для wide character функций
+#include <string_view>
+#include "../common/modAlphabet.h"
+#include "../common/modCipherBatch.h"
+#include "../common/modCipherError.h"
+#include "../common/modCipherStatus.h"
+#include "../common/modIndexedText.h"
+#include "../common/modNormalize.h"
+#include "../common/modStats.h"
+#include "modKeySchedule.h"
+#include "modShiftKernel.h"
 
 /**
- * @brief Класс исключений для ошибок шифрования
- * @details Наследуется от std::invalid_argument
+ * @brief Класс для шифрования методом Гронсфельда
+ * @details Реализует шифрование и дешифрование текста на русском языке.
+ * Все методы шифрования и дешифрования константны: подготовленный ключ
+ * после построения только читается, а рабочие буферы выделяются на стеке
+ * вызова. Поэтому один объект можно без блокировок использовать из
+ * нескольких потоков одновременно; исключение - rekey(), который нельзя
+ * вызывать параллельно с шифрованием
  */
-class cipher_error : public std::invalid_argument {
+class modAlphaCipher {
+    friend class modAlphaStream;
+    friend class modProductCipher;
+private:
+    std::shared_ptr<const KeySchedule> schedule; /// Подготовленный ключ, общий для шифраторов с одинаковым ключом
+    shift_strategy strategy;                     /// Запрошенный способ сдвига
+    bool useTable = false;                       /// Сдвиг по таблице подстановок ключа
+    
+    /// Размер блока номеров букв, обрабатываемого ядром сдвига за раз
+    static constexpr size_t blockSize = 4096;
+    
 public:
+    /// Длина текста, начиная с которой параллельный режим использует потоки
+    static constexpr size_t parallelThreshold = 1 << 16;
+    
+    /// Наибольшее число подготовленных ключей в общем кэше
+    static constexpr size_t scheduleCacheSize = 64;
+    
+    /// Наибольший суммарный размер подготовленных ключей в общем кэше, байт
+    static constexpr size_t scheduleCacheBytes = size_t(1) << 20;
+    
+    /// Наибольший размер подготовленного ключа, который кэшируется, байт
+    static constexpr size_t scheduleEntryBytes = size_t(64) << 10;
+    
+private:
+
     /**
-     * @brief Конструктор с строковым параметром
-     * @param [in] what_arg Сообщение об ошибке
+     * @brief Общий кэш подготовленных ключей
+     * @return Кэш емкостью scheduleCacheSize и scheduleCacheBytes
      */
-    explicit cipher_error(const std::string& what_arg) : std::invalid_argument(what_arg) {}
+    static KeyScheduleCache& scheduleCache();
     
     /**
-     * @brief Конструктор с C-строкой
-     * @param [in] what_arg Сообщение об ошибке
+     * @brief Валидация ключа шифрования
+     * @param [in] s Ключ для проверки
+     * @return Валидный ключ в верхнем регистре
+     * @throw cipher_error Если ключ пустой или содержит не-буквенные символы
      */
-    explicit cipher_error(const char* what_arg) : std::invalid_argument(what_arg) {}
-};
-
-/**
- * @brief Класс для шифрования методом Гронсфельда
- * @details Реализует шифрование и дешифрование текста на русском языке
- */
-class modAlphaCipher {
-private:
-    std::wstring numAlpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ"; /// Русский алфавит
-    std::map<wchar_t, int> alphaNum; /// Ассоциативный массив "символ-номер"
-    std::vector<int> key; /// Ключ шифрования в числовом виде
-
+    std::wstring getValidKey(const std::wstring& s);
+    
     /**
-     * @brief Преобразование строки в числовой вектор
-     * @param [in] s Строка для преобразования
-     * @return Вектор числовых представлений символов
+     * @brief Шифрование фрагмента текста с заданной фазы ключа
+     * @param [in] in Фрагмент открытого текста
+     * @param [in] len Длина фрагмента
+     * @param [out] out Буфер для зашифрованного текста
+     * @param [in] capacity Размер буфера в символах
+     * @param [in,out] phase Позиция в ключе, обновляется по числу букв
+     * @return Количество записанных символов (может быть 0)
+     * @throw cipher_error Если буфер слишком мал
      */
-    std::vector<int> convert(const std::wstring& s);
+    size_t encryptChunk(const wchar_t* in, size_t len, wchar_t* out, size_t capacity, size_t& phase) const;
     
     /**
-     * @brief Преобразование числового вектора в строку
-     * @param [in] v Числовой вектор для преобразования
-     * @return Строка, восстановленная из числовых представлений
+     * @brief Дешифрование фрагмента текста с заданной фазы ключа
+     * @param [in] in Фрагмент зашифрованного текста
+     * @param [in] len Длина фрагмента
+     * @param [out] out Буфер для расшифрованного текста
+     * @param [in] capacity Размер буфера в символах
+     * @param [in,out] phase Позиция в ключе, обновляется по числу букв
+     * @return Количество записанных символов
+     * @throw cipher_error Если фрагмент содержит не-прописные буквы или буфер слишком мал
      */
-    std::wstring convert(const std::vector<int>& v);
+    size_t decryptChunk(const wchar_t* in, size_t len, wchar_t* out, size_t capacity, size_t& phase) const;
     
     /**
-     * @brief Преобразование символа в верхний регистр
-     * @param [in] c Символ для преобразования
-     * @return Символ в верхнем регистре
+     * @brief Дешифрование фрагмента текста без исключений
+     * @details Блок проверяется и переводится в номера одним векторным
+     * проходом Normalize::upperIndices(), который сразу дает позицию ошибки
+     * @param [in] in Фрагмент зашифрованного текста
+     * @param [in] len Длина фрагмента
+     * @param [out] out Буфер для расшифрованного текста длиной не менее len
+     * @param [in,out] phase Позиция в ключе, обновляется по числу букв
+     * @return len при успехе или позиция первого не-прописного символа
      */
-    static wchar_t toUpper(wchar_t c);
+    size_t decryptBlocks(const wchar_t* in, size_t len, wchar_t* out, size_t& phase) const noexcept;
     
     /**
-     * @brief Валидация ключа шифрования
-     * @param [in] s Ключ для проверки
-     * @return Валидный ключ в верхнем регистре
-     * @throw cipher_error Если ключ пустой или содержит не-буквенные символы
+     * @brief Шифрование фрагмента текста в UTF-8 с заданной фазы ключа
+     * @param [in] in Фрагмент открытого текста в UTF-8
+     * @param [in] len Длина фрагмента в байтах
+     * @param [out] out Буфер для зашифрованного текста в UTF-8
+     * @param [in] capacity Размер буфера в байтах
+     * @param [in,out] phase Позиция в ключе, обновляется по числу букв
+     * @return Количество записанных байтов (может быть 0)
+     * @throw cipher_error Если буфер слишком мал
      */
-    std::wstring getValidKey(const std::wstring& s);
+    size_t encryptChunk(const char* in, size_t len, char* out, size_t capacity, size_t& phase) const;
     
     /**
-     * @brief Валидация открытого текста
-     * @param [in] s Текст для проверки
-     * @return Валидный текст только с буквами в верхнем регистре
-     * @throw cipher_error Если текст не содержит букв после очистки
+     * @brief Дешифрование фрагмента текста в UTF-8 с заданной фазы ключа
+     * @param [in] in Фрагмент зашифрованного текста в UTF-8
+     * @param [in] len Длина фрагмента в байтах
+     * @param [out] out Буфер для расшифрованного текста в UTF-8
+     * @param [in] capacity Размер буфера в байтах
+     * @param [in,out] phase Позиция в ключе, обновляется по числу букв
+     * @return Количество записанных байтов
+     * @throw cipher_error Если фрагмент содержит не-прописные буквы или буфер слишком мал
      */
-    std::wstring getValidOpenText(const std::wstring& s);
+    size_t decryptChunk(const char* in, size_t len, char* out, size_t capacity, size_t& phase) const;
     
     /**
-     * @brief Валидация зашифрованного текста
-     * @param [in] s Зашифрованный текст для проверки
-     * @return Валидный зашифрованный текст
-     * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+     * @brief Сдвиг текста из номеров букв по ключевому потоку
+     * @param [in] text Исходный текст
+     * @param [in] inverse Обратный сдвиг для дешифрования
+     * @return Сдвинутый текст
+     */
+    IndexedText shiftText(const IndexedText& text, bool inverse) const;
+    
+    /**
+     * @brief Сдвиг блока номеров букв выбранным способом
+     * @param [in,out] work Номера букв 0..32
+     * @param [in] m Количество номеров
+     * @param [in] inverse Обратный сдвиг для дешифрования
+     * @param [in] phase Позиция в ключе для work[0]
+     * @return Позиция в ключе для следующей буквы
      */
-    std::wstring getValidCipherText(const std::wstring& s);
+    size_t shiftBlock(uint8_t* work, size_t m, bool inverse, size_t phase) const noexcept;
     
 public:
     /**
@@ -97,10 +158,67 @@ public:
     
     /**
      * @brief Конструктор с параметром ключа
+     * @details При shift_strategy::table и shift_strategy::automatic
+     * таблица подстановок используется только для ключей, таблица которых
+     * помещается в shiftTableLimit; более длинные ключи сдвигаются
+     * векторным ядром. Результат от способа не зависит
      * @param [in] skey Ключ шифрования
+     * @param [in] how Способ сдвига букв по ключу
      * @throw cipher_error Если ключ невалиден
      */
-    modAlphaCipher(const std::wstring& skey);
+    modAlphaCipher(const std::wstring& skey, shift_strategy how = shift_strategy::automatic);
+    
+    /**
+     * @brief Счетчики шифра Гронсфельда
+     * @details Общие для всех шифраторов; обновляются только при сборке с
+     * CIPHER_STATS. Снимок stats().snapshot() не блокирует шифрование
+     * @return Счетчики
+     */
+    static CipherStats& stats() noexcept;
+    
+    /**
+     * @brief Способ сдвига, выбранный для текущего ключа
+     * @return shift_strategy::table или shift_strategy::arithmetic
+     */
+    shift_strategy shiftStrategy() const noexcept {
+        return useTable ? shift_strategy::table : shift_strategy::arithmetic;
+    }
+    
+    /**
+     * @brief Смена ключа без создания нового шифратора
+     * @details Ключ проверяется заново, а подготовленный ключ берется из
+     * общего кэша или готовится и помещается в него. Способ сдвига
+     * выбирается заново для нового ключа. Вызов не должен
+     * выполняться одновременно с шифрованием тем же объектом
+     * @param [in] skey Новый ключ шифрования
+     * @throw cipher_error Если ключ невалиден; прежний ключ сохраняется
+     */
+    void rekey(const std::wstring& skey);
+    
+    /**
+     * @brief Проверка ключа без исключений
+     * @param [in] s Ключ для проверки
+     * @return cipher_status::invalid_key и позиция первого не-буквенного
+     * символа (0 для пустого ключа) или успешный результат
+     */
+    static cipher_result checkKey(std::wstring_view s) noexcept;
+    
+    /**
+     * @brief Шифрование открытого текста без исключений
+     * @param [in] open_text Открытый текст для шифрования
+     * @param [out] out Зашифрованный текст (пустой при ошибке)
+     * @return cipher_status::empty_text, если текст не содержит букв
+     */
+    cipher_result tryEncrypt(std::wstring_view open_text, std::wstring& out) const;
+    
+    /**
+     * @brief Дешифрование зашифрованного текста без исключений
+     * @param [in] cipher_text Зашифрованный текст для дешифрования
+     * @param [out] out Расшифрованный текст (пустой при ошибке)
+     * @return cipher_status::empty_text для пустого текста или
+     * cipher_status::invalid_text и позиция первого не-прописного символа
+     */
+    cipher_result tryDecrypt(std::wstring_view cipher_text, std::wstring& out) const;
     
     /**
      * @brief Шифрование открытого текста
@@ -108,7 +226,7 @@ public:
      * @return Зашифрованный текст
      * @throw cipher_error Если текст невалиден
      */
-    std::wstring encrypt(const std::wstring& open_text);
+    std::wstring encrypt(const std::wstring& open_text) const;
     
     /**
      * @brief Дешифрование зашифрованного текста
@@ -116,5 +234,180 @@ public:
      * @return Расшифрованный текст
      * @throw cipher_error Если текст невалиден
      */
-    std::wstring decrypt(const std::wstring& cipher_text);
+    std::wstring decrypt(const std::wstring& cipher_text) const;
+    
+    /**
+     * @brief Шифрование открытого текста с результатом из заданного источника памяти
+     * @details Промежуточные буферы размещаются на стеке, поэтому из
+     * источника выделяется только результат
+     * @param [in] open_text Открытый текст для шифрования
+     * @param [in] mr Источник памяти для результата
+     * @return Зашифрованный текст
+     * @throw cipher_error Если текст не содержит букв
+     */
+    std::pmr::wstring encrypt(std::wstring_view open_text, std::pmr::memory_resource* mr) const;
+    
+    /**
+     * @brief Дешифрование зашифрованного текста с результатом из заданного источника памяти
+     * @param [in] cipher_text Зашифрованный текст для дешифрования
+     * @param [in] mr Источник памяти для результата
+     * @return Расшифрованный текст
+     * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+     */
+    std::pmr::wstring decrypt(std::wstring_view cipher_text, std::pmr::memory_resource* mr) const;
+    
+    /**
+     * @brief Шифрование текста из номеров букв
+     * @details Текст проверен и нормализован при построении IndexedText,
+     * поэтому выполняется только сдвиг однобайтовых номеров
+     * @param [in] open_text Открытый текст
+     * @return Зашифрованный текст
+     * @throw cipher_error Если текст пустой
+     */
+    IndexedText encrypt(const IndexedText& open_text) const;
+    
+    /**
+     * @brief Дешифрование текста из номеров букв
+     * @param [in] cipher_text Зашифрованный текст
+     * @return Расшифрованный текст
+     * @throw cipher_error Если текст пустой
+     */
+    IndexedText decrypt(const IndexedText& cipher_text) const;
+    
+    /**
+     * @brief Шифрование открытого текста в буфер вызывающей стороны
+     * @details Фильтрация, приведение регистра, сдвиг и запись выполняются
+     * за один проход по входному тексту без промежуточных выделений памяти.
+     * Достаточно буфера размером open_text.size()
+     * @param [in] open_text Открытый текст для шифрования
+     * @param [out] out Буфер для зашифрованного текста
+     * @param [in] capacity Размер буфера в символах
+     * @return Количество записанных символов
+     * @throw cipher_error Если текст не содержит букв или буфер слишком мал
+     */
+    size_t encryptInto(const std::wstring& open_text, wchar_t* out, size_t capacity) const;
+    
+    /**
+     * @brief Дешифрование зашифрованного текста в буфер вызывающей стороны
+     * @details Проверка, сдвиг и запись выполняются за один проход.
+     * Достаточно буфера размером cipher_text.size()
+     * @param [in] cipher_text Зашифрованный текст для дешифрования
+     * @param [out] out Буфер для расшифрованного текста
+     * @param [in] capacity Размер буфера в символах
+     * @return Количество записанных символов
+     * @throw cipher_error Если текст невалиден или буфер слишком мал
+     */
+    size_t decryptInto(const std::wstring& cipher_text, wchar_t* out, size_t capacity) const;
+    
+    /**
+     * @brief Шифрование открытого текста в UTF-8
+     * @details Двухбайтовые последовательности русских букв разбираются
+     * напрямую, остальные символы отбрасываются без преобразования в wstring
+     * @param [in] open_text Открытый текст в UTF-8
+     * @return Зашифрованный текст в UTF-8
+     * @throw cipher_error Если текст не содержит букв
+     */
+    std::string encrypt(std::string_view open_text) const;
+    
+    /**
+     * @brief Дешифрование зашифрованного текста в UTF-8
+     * @param [in] cipher_text Зашифрованный текст в UTF-8
+     * @return Расшифрованный текст в UTF-8
+     * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+     */
+    std::string decrypt(std::string_view cipher_text) const;
+    
+    /**
+     * @brief Шифрование открытого текста в UTF-8 в буфер вызывающей стороны
+     * @details Достаточно буфера размером open_text.size()
+     * @param [in] open_text Открытый текст в UTF-8
+     * @param [out] out Буфер для зашифрованного текста
+     * @param [in] capacity Размер буфера в байтах
+     * @return Количество записанных байтов
+     * @throw cipher_error Если текст не содержит букв или буфер слишком мал
+     */
+    size_t encryptInto(std::string_view open_text, char* out, size_t capacity) const;
+    
+    /**
+     * @brief Дешифрование зашифрованного текста в UTF-8 в буфер вызывающей стороны
+     * @details Достаточно буфера размером cipher_text.size()
+     * @param [in] cipher_text Зашифрованный текст в UTF-8
+     * @param [out] out Буфер для расшифрованного текста
+     * @param [in] capacity Размер буфера в байтах
+     * @return Количество записанных байтов
+     * @throw cipher_error Если текст невалиден или буфер слишком мал
+     */
+    size_t decryptInto(std::string_view cipher_text, char* out, size_t capacity) const;
+    
+    /**
+     * @brief Параллельное шифрование открытого текста
+     * @details Текст делится на участки; сначала параллельно считается
+     * число букв в каждом участке, затем каждый поток шифрует свой участок
+     * с фазы ключа, равной смещению участка в результате. Для текстов
+     * короче parallelThreshold выполняется обычное шифрование
+     * @param [in] open_text Открытый текст для шифрования
+     * @param [in] threads Количество потоков (0 - по числу ядер)
+     * @return Зашифрованный текст, совпадающий с результатом encrypt()
+     * @throw cipher_error Если текст невалиден
+     */
+    std::wstring encryptParallel(const std::wstring& open_text, unsigned threads = 0) const;
+    
+    /**
+     * @brief Параллельное дешифрование зашифрованного текста
+     * @details Для текстов короче parallelThreshold выполняется обычное дешифрование
+     * @param [in] cipher_text Зашифрованный текст для дешифрования
+     * @param [in] threads Количество потоков (0 - по числу ядер)
+     * @return Расшифрованный текст, совпадающий с результатом decrypt()
+     * @throw cipher_error Если текст невалиден
+     */
+    std::wstring decryptParallel(const std::wstring& cipher_text, unsigned threads = 0) const;
+    
+    /**
+     * @brief Дешифрование участка зашифрованного текста
+     * @details Буква с позиции pos сдвигается с фазы ключа pos % длина ключа,
+     * поэтому читаются и проверяются только буквы участка. Для
+     * отображенного в память шифротекста запрос стоит O(len)
+     * @param [in] cipher_text Весь зашифрованный текст
+     * @param [in] pos Позиция первой буквы участка
+     * @param [in] len Количество букв участка
+     * @return Расшифрованный участок, совпадающий с decrypt().substr(pos, len)
+     * @throw cipher_error Если участок выходит за текст или содержит
+     * не-прописные буквы
+     */
+    std::wstring decryptRange(std::wstring_view cipher_text, size_t pos, size_t len) const;
+    
+    /**
+     * @brief Дешифрование участка зашифрованного текста в UTF-8
+     * @details Каждая буква шифротекста занимает два байта, поэтому буква
+     * pos начинается с байта 2 * pos
+     * @param [in] cipher_text Весь зашифрованный текст в UTF-8
+     * @param [in] pos Позиция первой буквы участка
+     * @param [in] len Количество букв участка
+     * @return Расшифрованный участок в UTF-8
+     * @throw cipher_error Если участок выходит за текст или содержит
+     * не-прописные буквы
+     */
+    std::string decryptRange(std::string_view cipher_text, size_t pos, size_t len) const;
+    
+    /**
+     * @brief Пакетное шифрование сообщений
+     * @details Каждое сообщение шифруется независимо с начала ключа, как
+     * отдельным вызовом encrypt(). Результаты пишутся подряд в out.arena;
+     * сообщение без букв отмечается cipher_status::empty_text и не
+     * прерывает обработку остальных
+     * @param [in] texts Открытые тексты
+     * @param [in] count Количество сообщений
+     * @param [out] out Результаты пакета
+     */
+    void encryptBatch(const std::wstring_view* texts, size_t count, CipherBatch& out) const;
+    
+    /**
+     * @brief Пакетное дешифрование сообщений
+     * @details Пустое сообщение отмечается cipher_status::empty_text,
+     * сообщение с не-прописными буквами - cipher_status::invalid_text
+     * @param [in] texts Зашифрованные тексты
+     * @param [in] count Количество сообщений
+     * @param [out] out Результаты пакета
+     */
+    void decryptBatch(const std::wstring_view* texts, size_t count, CipherBatch& out) const;
 };
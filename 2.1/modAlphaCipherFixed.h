@@ -0,0 +1,257 @@
+/**
+ * @file modAlphaCipherFixed.h
+ * @brief Заголовочный файл для шаблона modAlphaCipherFixed
+ * @details Шифр Гронсфельда с ключом, известным на этапе компиляции
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include "../common/modAlphabet.h"
+#include "../common/modCipherError.h"
+#include "../common/modNormalize.h"
+#include "modShiftKernel.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ALPHA_FIXED_X86 1
+#endif
+
+/**
+ * @brief Ядра сдвига с длиной ключа, известной при компиляции
+ * @details Шаг фазы (phase + shiftKernelWidth) % K вычисляется без деления,
+ * а при K, делящем shiftKernelWidth, вектор сдвигов загружается один раз
+ * до цикла
+ */
+namespace alpha_fixed_detail {
+
+/**
+ * @brief Скалярный сдвиг
+ * @tparam K Длина ключа
+ * @param [in,out] d Номера букв
+ * @param [in] n Количество номеров
+ * @param [in] s Развернутый ключевой поток
+ * @param [in] phase Позиция в ключе для d[0]
+ * @return Позиция в ключе для следующего символа
+ */
+template <size_t K>
+inline size_t shiftScalar(uint8_t* d, size_t n, const uint8_t* s, size_t phase) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        unsigned v = d[i] + s[phase];
+        d[i] = static_cast<uint8_t>(v >= Alphabet::size ? v - Alphabet::size : v);
+        if (++phase == K) {
+            phase = 0;
+        }
+    }
+    return phase;
+}
+
+#if defined(ALPHA_FIXED_X86)
+/**
+ * @brief Сдвиг на AVX2 (два 32-байтных регистра за шаг)
+ * @tparam K Длина ключа
+ */
+template <size_t K>
+__attribute__((target("avx2")))
+inline size_t shiftAvx2(uint8_t* d, size_t n, const uint8_t* s, size_t phase) noexcept {
+    const __m256i m = _mm256_set1_epi8(static_cast<char>(Alphabet::size));
+    if constexpr (shiftKernelWidth % K == 0) {
+        // Фаза не меняется между шагами
+        const __m256i ka = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + phase));
+        const __m256i kb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + phase + 32));
+        for (; n >= shiftKernelWidth; n -= shiftKernelWidth, d += shiftKernelWidth) {
+            __m256i a = _mm256_add_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(d)), ka);
+            __m256i b = _mm256_add_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + 32)), kb);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), _mm256_min_epu8(a, _mm256_sub_epi8(a, m)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 32), _mm256_min_epu8(b, _mm256_sub_epi8(b, m)));
+        }
+    } else {
+        for (; n >= shiftKernelWidth; n -= shiftKernelWidth, d += shiftKernelWidth) {
+            const uint8_t* k = s + phase;
+            __m256i a = _mm256_add_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(d)),
+                                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(k)));
+            __m256i b = _mm256_add_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + 32)),
+                                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(k + 32)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), _mm256_min_epu8(a, _mm256_sub_epi8(a, m)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 32), _mm256_min_epu8(b, _mm256_sub_epi8(b, m)));
+            phase = (phase + shiftKernelWidth) % K;
+        }
+    }
+    return shiftScalar<K>(d, n, s, phase);
+}
+
+/**
+ * @brief Сдвиг на AVX-512BW (один 64-байтный регистр за шаг)
+ * @tparam K Длина ключа
+ */
+template <size_t K>
+__attribute__((target("avx512f,avx512bw")))
+inline size_t shiftAvx512(uint8_t* d, size_t n, const uint8_t* s, size_t phase) noexcept {
+    const __m512i m = _mm512_set1_epi8(static_cast<char>(Alphabet::size));
+    if constexpr (shiftKernelWidth % K == 0) {
+        // Фаза не меняется между шагами
+        const __m512i k = _mm512_loadu_si512(s + phase);
+        for (; n >= shiftKernelWidth; n -= shiftKernelWidth, d += shiftKernelWidth) {
+            __m512i a = _mm512_add_epi8(_mm512_loadu_si512(d), k);
+            _mm512_storeu_si512(d, _mm512_min_epu8(a, _mm512_sub_epi8(a, m)));
+        }
+    } else {
+        for (; n >= shiftKernelWidth; n -= shiftKernelWidth, d += shiftKernelWidth) {
+            __m512i a = _mm512_add_epi8(_mm512_loadu_si512(d), _mm512_loadu_si512(s + phase));
+            _mm512_storeu_si512(d, _mm512_min_epu8(a, _mm512_sub_epi8(a, m)));
+            phase = (phase + shiftKernelWidth) % K;
+        }
+    }
+    return shiftScalar<K>(d, n, s, phase);
+}
+#endif
+
+/**
+ * @brief Уровень векторных команд
+ * @return 2 для AVX-512BW, 1 для AVX2, 0 без них
+ */
+inline int simdLevel() noexcept {
+#if defined(ALPHA_FIXED_X86)
+    static const int level = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512bw") ? 2 : __builtin_cpu_supports("avx2") ? 1 : 0;
+    }();
+    return level;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Сдвиг лучшим доступным ядром
+ * @details Без x86 используется общее ядро shiftIndices (в том числе NEON)
+ * @tparam K Длина ключа
+ */
+template <size_t K>
+inline size_t shift(uint8_t* d, size_t n, const uint8_t* s, size_t phase) noexcept {
+#if defined(ALPHA_FIXED_X86)
+    switch (simdLevel()) {
+    case 2:
+        return shiftAvx512<K>(d, n, s, phase);
+    case 1:
+        return shiftAvx2<K>(d, n, s, phase);
+    default:
+        return shiftScalar<K>(d, n, s, phase);
+    }
+#else
+    return shiftIndices(d, n, s, K, phase);
+#endif
+}
+
+}
+
+/**
+ * @brief Шифр Гронсфельда с ключом, заданным параметрами шаблона
+ * @details Ключ проверяется при компиляции, развернутые ключевые потоки
+ * строятся как константы, а ядро сдвига alpha_fixed_detail::shift<keySize>
+ * инстанцируется под длину ключа: шаг фазы не требует деления, а для
+ * ключей, длина которых делит shiftKernelWidth, сдвиги загружаются один
+ * раз на блок. Сдвиг занимает около десятой части времени шифрования,
+ * остальное - общие с modAlphaCipher нормализация и запись, поэтому
+ * выигрыш невелик (в пределах 10%). Подготовка ключа и кэш не нужны.
+ * Результат совпадает с modAlphaCipher с тем же ключом, включая
+ * сообщения исключений
+ * @tparam Key Буквы ключа (любого регистра), например L'К', L'Л', L'Ю', L'Ч'
+ */
+template <wchar_t... Key>
+class modAlphaCipherFixed {
+    static_assert(sizeof...(Key) > 0, "Empty key");
+    static_assert(((Alphabet::index(Key) >= 0) && ...), "Invalid key: non-alphabetic character");
+
+public:
+    /// Длина ключа
+    static constexpr size_t keySize = sizeof...(Key);
+
+private:
+    /// Развернутый поток длиной keySize + shiftKernelWidth, как у shiftKeyStream()
+    using Stream = std::array<uint8_t, keySize + shiftKernelWidth>;
+
+    /**
+     * @brief Построение развернутого ключевого потока
+     * @param [in] inverse Поток обратных сдвигов для дешифрования
+     * @return Развернутый поток
+     */
+    static constexpr Stream makeStream(bool inverse) {
+        constexpr int key[keySize] = {Alphabet::index(Key)...};
+        Stream stream{};
+        for (size_t i = 0; i < stream.size(); ++i) {
+            int k = key[i % keySize];
+            stream[i] = static_cast<uint8_t>(inverse ? (Alphabet::size - k) % Alphabet::size : k);
+        }
+        return stream;
+    }
+
+    /// Поток сдвигов для шифрования
+    static constexpr Stream encStream = makeStream(false);
+    /// Поток сдвигов для дешифрования
+    static constexpr Stream decStream = makeStream(true);
+    /// Размер блока текста, обрабатываемого за раз
+    static constexpr size_t blockSize = 4096;
+
+public:
+    /**
+     * @brief Шифрование открытого текста
+     * @param [in] open_text Открытый текст для шифрования
+     * @return Зашифрованный текст
+     * @throw cipher_error Если текст не содержит букв
+     */
+    std::wstring encrypt(const std::wstring& open_text) const {
+        std::wstring result(open_text.size(), L'\0');
+        uint8_t work[blockSize];
+        size_t pos = 0;
+        size_t n = 0;
+        size_t phase = 0;
+        while (pos < open_text.size()) {
+            size_t step = std::min(blockSize, open_text.size() - pos);
+            size_t m = Normalize::indices(open_text.data() + pos, step, work);
+            pos += step;
+            phase = alpha_fixed_detail::shift<keySize>(work, m, encStream.data(), phase);
+            for (size_t j = 0; j < m; ++j) {
+                result[n + j] = Alphabet::letter(work[j]);
+            }
+            n += m;
+        }
+        if (n == 0) {
+            throwCipherError("Empty text, no letters");
+        }
+        result.resize(n);
+        return result;
+    }
+
+    /**
+     * @brief Дешифрование зашифрованного текста
+     * @param [in] cipher_text Зашифрованный текст для дешифрования
+     * @return Расшифрованный текст
+     * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+     */
+    std::wstring decrypt(const std::wstring& cipher_text) const {
+        if (cipher_text.empty()) {
+            throwCipherError("Empty cipher text");
+        }
+        const size_t len = cipher_text.size();
+        std::wstring result(len, L'\0');
+        uint8_t work[blockSize];
+        size_t phase = 0;
+        for (size_t n = 0; n < len; n += blockSize) {
+            size_t m = std::min(blockSize, len - n);
+            if (Normalize::upperIndices(cipher_text.data() + n, m, work) != m) {
+                throwCipherError("Incorrect data entry");
+            }
+            phase = alpha_fixed_detail::shift<keySize>(work, m, decStream.data(), phase);
+            for (size_t j = 0; j < m; ++j) {
+                result[n + j] = Alphabet::letter(work[j]);
+            }
+        }
+        return result;
+    }
+};
@@ -0,0 +1,113 @@
+/**
+ * @file modAlphaStream.cpp
+ * @brief Реализация класса modAlphaStream
+ * @details Содержит реализацию потокового шифрования методом Гронсфельда
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include "modAlphaStream.h"
+
+/**
+ * @brief Конструктор по шифратору с ключом
+ * @param [in] c Шифратор, ключ которого используется
+ * @param [in] m Направление преобразования
+ */
+modAlphaStream::modAlphaStream(const modAlphaCipher& c, Mode m) : cipher(c), mode(m) {}
+
+/**
+ * @brief Обработка очередного фрагмента в буфер вызывающей стороны
+ * @param [in] chunk Очередной фрагмент текста
+ * @param [out] out Буфер для результата
+ * @param [in] capacity Размер буфера в символах
+ * @return Количество записанных символов
+ * @throw cipher_error Если фрагмент шифротекста невалиден или буфер слишком мал
+ */
+size_t modAlphaStream::update(const std::wstring& chunk, wchar_t* out, size_t capacity) {
+    // Фаза обновляется только после успешной обработки фрагмента
+    size_t p = phase;
+    size_t n;
+    if (mode == Mode::Encrypt) {
+        n = cipher.encryptChunk(chunk.data(), chunk.size(), out, capacity, p);
+    } else {
+        n = cipher.decryptChunk(chunk.data(), chunk.size(), out, capacity, p);
+    }
+    phase = p;
+    count += n;
+    return n;
+}
+
+/**
+ * @brief Обработка очередного фрагмента
+ * @param [in] chunk Очередной фрагмент текста
+ * @return Результат преобразования фрагмента
+ * @throw cipher_error Если фрагмент шифротекста невалиден
+ */
+std::wstring modAlphaStream::update(const std::wstring& chunk) {
+    std::wstring result(chunk.size(), L'\0');
+    result.resize(update(chunk, &result[0], result.size()));
+    return result;
+}
+
+/**
+ * @brief Обработка очередного фрагмента в UTF-8 в буфер вызывающей стороны
+ * @param [in] chunk Очередной фрагмент текста в UTF-8
+ * @param [out] out Буфер для результата
+ * @param [in] capacity Размер буфера в байтах
+ * @return Количество записанных байтов
+ * @throw cipher_error Если фрагмент шифротекста невалиден или буфер слишком мал
+ */
+size_t modAlphaStream::update(std::string_view chunk, char* out, size_t capacity) {
+    size_t p = phase;
+    size_t n;
+    if (mode == Mode::Encrypt) {
+        n = cipher.encryptChunk(chunk.data(), chunk.size(), out, capacity, p);
+    } else {
+        n = cipher.decryptChunk(chunk.data(), chunk.size(), out, capacity, p);
+    }
+    phase = p;
+    count += n / 2;
+    return n;
+}
+
+/**
+ * @brief Количество букв во фрагменте открытого текста в UTF-8
+ * @param [in] chunk Фрагмент текста в UTF-8
+ * @return Количество букв
+ */
+size_t modAlphaStream::countLetters(std::string_view chunk) noexcept {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(chunk.data());
+    const unsigned char* end = p + chunk.size();
+    size_t n = 0;
+    while (p < end) {
+        if (Alphabet::utf8Next(p, end) >= 0)
+            ++n;
+    }
+    return n;
+}
+
+/**
+ * @brief Переход к заданной букве текста
+ * @param [in] letters Количество букв перед следующим фрагментом
+ */
+void modAlphaStream::seek(size_t letters) {
+    count = letters;
+    phase = letters % cipher.schedule->key.size();
+}
+
+/**
+ * @brief Количество обработанных букв
+ * @return Число обработанных букв
+ */
+size_t modAlphaStream::processed() const {
+    return count;
+}
+
+/**
+ * @brief Сброс потока к началу ключа
+ */
+void modAlphaStream::reset() {
+    count = 0;
+    phase = 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file modAlphaStream.h
+ * @brief Заголовочный файл для класса modAlphaStream
+ * @details Потоковое шифрование методом Гронсфельда по фрагментам
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <string>
+#include <string_view>
+#include "modAlphaCipher.h"
+
+/**
+ * @brief Класс потокового шифрования методом Гронсфельда
+ * @details Принимает текст произвольными фрагментами и хранит позицию в
+ * ключе между вызовами, поэтому результат последовательных вызовов
+ * update() совпадает с результатом modAlphaCipher для всего текста сразу
+ */
+class modAlphaStream {
+public:
+    /**
+     * @brief Направление преобразования
+     */
+    enum class Mode {
+        Encrypt, ///< Шифрование
+        Decrypt  ///< Дешифрование
+    };
+    
+private:
+    modAlphaCipher cipher; /// Шифратор с подготовленным ключом
+    Mode mode; /// Направление преобразования
+    size_t count = 0; /// Количество обработанных букв
+    size_t phase = 0; /// Текущая позиция в ключе
+    
+public:
+    /**
+     * @brief Конструктор по шифратору с ключом
+     * @param [in] c Шифратор, ключ которого используется
+     * @param [in] m Направление преобразования
+     */
+    modAlphaStream(const modAlphaCipher& c, Mode m);
+    
+    /**
+     * @brief Обработка очередного фрагмента в буфер вызывающей стороны
+     * @details При шифровании не-буквенные символы отбрасываются, фрагмент
+     * без букв допустим. Достаточно буфера размером chunk.size()
+     * @param [in] chunk Очередной фрагмент текста
+     * @param [out] out Буфер для результата
+     * @param [in] capacity Размер буфера в символах
+     * @return Количество записанных символов
+     * @throw cipher_error Если фрагмент шифротекста невалиден или буфер слишком мал
+     */
+    size_t update(const std::wstring& chunk, wchar_t* out, size_t capacity);
+    
+    /**
+     * @brief Обработка очередного фрагмента
+     * @param [in] chunk Очередной фрагмент текста
+     * @return Результат преобразования фрагмента
+     * @throw cipher_error Если фрагмент шифротекста невалиден
+     */
+    std::wstring update(const std::wstring& chunk);
+    
+    /**
+     * @brief Обработка очередного фрагмента в UTF-8 в буфер вызывающей стороны
+     * @details Фрагмент не должен обрывать многобайтовую последовательность.
+     * Достаточно буфера размером chunk.size()
+     * @param [in] chunk Очередной фрагмент текста в UTF-8
+     * @param [out] out Буфер для результата
+     * @param [in] capacity Размер буфера в байтах
+     * @return Количество записанных байтов
+     * @throw cipher_error Если фрагмент шифротекста невалиден или буфер слишком мал
+     */
+    size_t update(std::string_view chunk, char* out, size_t capacity);
+    
+    /**
+     * @brief Количество букв во фрагменте открытого текста в UTF-8
+     * @details Буквы выделяются так же, как при шифровании, поэтому сумма
+     * по предыдущим фрагментам дает позицию для seek()
+     * @param [in] chunk Фрагмент текста в UTF-8
+     * @return Количество букв
+     */
+    static size_t countLetters(std::string_view chunk) noexcept;
+    
+    /**
+     * @brief Переход к заданной букве текста
+     * @details Позволяет обрабатывать фрагменты независимыми потоками,
+     * если известно, сколько букв им предшествует
+     * @param [in] letters Количество букв перед следующим фрагментом
+     */
+    void seek(size_t letters);
+    
+    /**
+     * @brief Количество обработанных букв
+     * @return Число букв, прошедших через поток с момента создания или сброса
+     */
+    size_t processed() const;
+    
+    /**
+     * @brief Сброс потока к началу ключа
+     */
+    void reset();
+};
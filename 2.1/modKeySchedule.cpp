@@ -0,0 +1,116 @@
+/**
+ * @file modKeySchedule.cpp
+ * @brief Реализация подготовленных ключей шифра Гронсфельда
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include "modKeySchedule.h"
+#include <algorithm>
+#include <functional>
+#include "../common/modAlphabet.h"
+#include "modShiftKernel.h"
+
+/**
+ * @brief Подготовка ключа
+ * @param [in] upperKey Валидный ключ прописными буквами
+ */
+KeySchedule::KeySchedule(const std::wstring& upperKey) : text(upperKey) {
+    key.reserve(text.size());
+    for (auto c : text) {
+        key.push_back(Alphabet::index(c));
+    }
+    // Развертывание ключа для ядра сдвига
+    encStream = shiftKeyStream(key, false);
+    decStream = shiftKeyStream(key, true);
+    if (key.size() * Alphabet::size <= shiftTableLimit) {
+        encTable = shiftKeyTable(key, false);
+        decTable = shiftKeyTable(key, true);
+    }
+}
+
+/**
+ * @brief Создание пустого кэша
+ * @param [in] cap Наибольшее число хранимых ключей
+ * @param [in] bytes Наибольший суммарный размер ключей в байтах
+ * @param [in] entry Наибольший размер кэшируемого ключа в байтах
+ */
+KeyScheduleCache::KeyScheduleCache(size_t cap, size_t bytes, size_t entry)
+    : capacity(cap), budget(bytes), entryLimit(entry), snapshot(std::make_shared<const Snapshot>()) {
+}
+
+/**
+ * @brief Поиск ключа в текущем снимке
+ * @param [in] upperKey Валидный ключ прописными буквами
+ * @param [in] hash Хеш ключа
+ * @return Подготовленный ключ или nullptr
+ */
+std::shared_ptr<const KeySchedule> KeyScheduleCache::find(const std::wstring& upperKey, size_t hash) {
+    std::shared_ptr<const Snapshot> current = std::atomic_load(&snapshot);
+    for (const auto& slot : *current) {
+        // Строки сравниваются только при совпадении хешей
+        if (slot->hash == hash && slot->schedule->text == upperKey) {
+            uint64_t now = generation.load(std::memory_order_relaxed);
+            if (slot->used.load(std::memory_order_relaxed) != now) {
+                slot->used.store(now, std::memory_order_relaxed);
+            }
+            return slot->schedule;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Публикация снимка с новым ключом
+ * @param [in] schedule Подготовленный ключ
+ * @param [in] hash Хеш ключа
+ * @return Добавленный ключ или такой же, добавленный другим потоком
+ */
+std::shared_ptr<const KeySchedule> KeyScheduleCache::insert(std::shared_ptr<const KeySchedule> schedule, size_t hash) {
+    const size_t size = schedule->bytes();
+    if (capacity == 0 || size > entryLimit || size > budget) {
+        return schedule;
+    }
+    std::lock_guard<std::mutex> guard(publish);
+    std::shared_ptr<const Snapshot> current = std::atomic_load(&snapshot);
+    for (const auto& slot : *current) {
+        if (slot->hash == hash && slot->schedule->text == schedule->text) {
+            return slot->schedule;
+        }
+    }
+    auto next = std::make_shared<Snapshot>(*current);
+    auto slot = std::make_shared<Slot>();
+    slot->hash = hash;
+    slot->schedule = schedule;
+    slot->used.store(generation.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    next->insert(next->begin(), slot);
+    size_t total = 0;
+    for (const auto& s : *next) {
+        total += s->schedule->bytes();
+    }
+    // Вытеснение давно не использованных ключей, новый ключ остается
+    while (next->size() > capacity || total > budget) {
+        auto oldest = std::min_element(next->begin() + 1, next->end(), [](const auto& a, const auto& b) {
+            return a->used.load(std::memory_order_relaxed) < b->used.load(std::memory_order_relaxed);
+        });
+        total -= (*oldest)->schedule->bytes();
+        next->erase(oldest);
+    }
+    std::atomic_store(&snapshot, std::shared_ptr<const Snapshot>(std::move(next)));
+    return schedule;
+}
+
+/**
+ * @brief Получение подготовленного ключа из кэша или подготовка нового
+ * @details Ключ готовится вне мьютекса кэша
+ * @param [in] upperKey Валидный ключ прописными буквами
+ * @return Подготовленный ключ
+ */
+std::shared_ptr<const KeySchedule> KeyScheduleCache::get(const std::wstring& upperKey) {
+    const size_t hash = std::hash<std::wstring>{}(upperKey);
+    if (auto schedule = find(upperKey, hash)) {
+        return schedule;
+    }
+    return insert(std::make_shared<const KeySchedule>(upperKey), hash);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file modKeySchedule.h
+ * @brief Заголовочный файл подготовленных ключей шифра Гронсфельда
+ * @details Подготовленный ключ неизменяем и разделяется между шифраторами
+ * через shared_ptr; кэш, ограниченный числом ключей и их суммарным
+ * размером, позволяет не готовить повторно часто используемые ключи
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Способ сдвига букв по ключу
+ */
+enum class shift_strategy {
+    automatic,  ///< Таблица, если нет векторного ядра и она помещается в L1
+    arithmetic, ///< Векторное ядро сложения по модулю
+    table       ///< Таблица подстановок по позициям ключа, если она помещается в L1
+};
+
+/**
+ * @brief Подготовленный ключ шифра Гронсфельда
+ * @details Таблицы подстановок строятся только для ключей, у которых
+ * таблица одного направления не больше shiftTableLimit байт
+ */
+struct KeySchedule {
+    std::wstring text;              ///< Ключ прописными буквами
+    std::vector<int> key;           ///< Ключ в числовом виде
+    std::vector<uint8_t> encStream; ///< Развернутый поток сдвигов для шифрования
+    std::vector<uint8_t> decStream; ///< Развернутый поток обратных сдвигов для дешифрования
+    std::vector<uint8_t> encTable;  ///< Таблица подстановок для шифрования (пуста для длинных ключей)
+    std::vector<uint8_t> decTable;  ///< Таблица подстановок для дешифрования (пуста для длинных ключей)
+
+    /**
+     * @brief Подготовка ключа
+     * @param [in] upperKey Валидный ключ прописными буквами
+     */
+    explicit KeySchedule(const std::wstring& upperKey);
+    
+    /**
+     * @brief Размер подготовленного ключа
+     * @return Размер ключа, потоков и таблиц в байтах
+     */
+    size_t bytes() const {
+        return text.size() * sizeof(wchar_t) + key.size() * sizeof(int) + encStream.size() + decStream.size()
+            + encTable.size() + decTable.size();
+    }
+};
+
+/**
+ * @brief Ограниченный кэш подготовленных ключей
+ * @details Хранит не более capacity ключей суммарным размером не более
+ * budget байтов; ключ больше entryLimit байтов не кэшируется. Поиск
+ * сравнивает хеши ключей в неизменяемом снимке списка и не берет
+ * мьютекс. Ключ готовится вне мьютекса, мьютекс защищает только
+ * публикацию нового снимка, при которой вытесняются давно не
+ * использованные ключи
+ */
+class KeyScheduleCache {
+private:
+    /**
+     * @brief Запись кэша
+     */
+    struct Slot {
+        size_t hash = 0;                             /// Хеш ключа
+        std::shared_ptr<const KeySchedule> schedule; /// Подготовленный ключ
+        std::atomic<uint64_t> used{0};               /// Поколение последнего использования
+    };
+    /// Неизменяемый список записей
+    using Snapshot = std::vector<std::shared_ptr<Slot>>;
+
+    size_t capacity;                          /// Наибольшее число ключей
+    size_t budget;                            /// Наибольший суммарный размер ключей в байтах
+    size_t entryLimit;                        /// Наибольший размер кэшируемого ключа в байтах
+    std::shared_ptr<const Snapshot> snapshot; /// Текущий список; читается через std::atomic_load
+    std::atomic<uint64_t> generation{0};      /// Счетчик публикаций снимка
+    std::mutex publish;                       /// Защита публикации снимка
+
+    /**
+     * @brief Поиск ключа в текущем снимке
+     * @param [in] upperKey Валидный ключ прописными буквами
+     * @param [in] hash Хеш ключа
+     * @return Подготовленный ключ или nullptr
+     */
+    std::shared_ptr<const KeySchedule> find(const std::wstring& upperKey, size_t hash);
+
+    /**
+     * @brief Публикация снимка с новым ключом
+     * @param [in] schedule Подготовленный ключ
+     * @param [in] hash Хеш ключа
+     * @return Добавленный ключ или такой же, добавленный другим потоком
+     */
+    std::shared_ptr<const KeySchedule> insert(std::shared_ptr<const KeySchedule> schedule, size_t hash);
+
+public:
+    /**
+     * @brief Создание пустого кэша
+     * @param [in] cap Наибольшее число хранимых ключей
+     * @param [in] bytes Наибольший суммарный размер ключей в байтах
+     * @param [in] entry Наибольший размер кэшируемого ключа в байтах
+     */
+    KeyScheduleCache(size_t cap, size_t bytes, size_t entry);
+
+    /**
+     * @brief Получение подготовленного ключа из кэша или подготовка нового
+     * @param [in] upperKey Валидный ключ прописными буквами
+     * @return Подготовленный ключ
+     */
+    std::shared_ptr<const KeySchedule> get(const std::wstring& upperKey);
+};
@@ -0,0 +1,176 @@
+/**
+ * @file modKeySource.cpp
+ * @brief Реализация источников бегущего ключа
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include "modKeySource.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../common/modAlphabet.h"
+#include "../common/modCipherError.h"
+
+namespace {
+
+/**
+ * @brief Разбор букв ключа из UTF-8
+ * @details Разбор останавливается после n букв или перед символом,
+ * оборванным концом данных, если данные еще не закончились
+ * @param [in,out] p Текущая позиция
+ * @param [in] end Конец данных
+ * @param [out] out Буфер для номеров букв
+ * @param [in] n Количество запрошенных букв
+ * @param [in] last Данные заканчиваются на end
+ * @return Количество разобранных букв
+ */
+size_t parseLetters(const unsigned char*& p, const unsigned char* end, uint8_t* out, size_t n, bool last) {
+    size_t m = 0;
+    while (m < n && p < end) {
+        if (*p < 0x80) {
+            ++p;
+            continue;
+        }
+        if (static_cast<size_t>(end - p) < static_cast<size_t>(Alphabet::utf8Length(*p)) && !last)
+            break;
+        int i = Alphabet::utf8Next(p, end);
+        if (i >= 0)
+            out[m++] = static_cast<uint8_t>(i);
+    }
+    return m;
+}
+
+} // namespace
+
+/**
+ * @brief Источник по тексту в UTF-8
+ * @param [in] text Текст ключа
+ */
+MemoryKeySource::MemoryKeySource(std::string_view text)
+    : pos(reinterpret_cast<const unsigned char*>(text.data())), end(pos + text.size()) {}
+
+/**
+ * @brief Чтение очередных букв ключа
+ * @param [out] out Буфер для номеров букв
+ * @param [in] n Количество запрошенных букв
+ * @return Количество прочитанных букв
+ */
+size_t MemoryKeySource::read(uint8_t* out, size_t n) {
+    return parseLetters(pos, end, out, n, true);
+}
+
+/**
+ * @brief Отображение файла ключа
+ * @param [in] path Путь к файлу в UTF-8
+ * @throw cipher_error Если файл не удалось открыть или отобразить
+ */
+MappedKeySource::MappedKeySource(const char* path) {
+    fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        throwCipherError("Cannot open key file");
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        throwCipherError("Cannot open key file");
+    }
+    length = static_cast<size_t>(st.st_size);
+    if (length != 0) {
+        map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            ::close(fd);
+            throwCipherError("Cannot map key file");
+        }
+        // Ключ читается один раз подряд
+        madvise(map, length, MADV_SEQUENTIAL);
+        pos = static_cast<const unsigned char*>(map);
+        end = pos + length;
+    }
+}
+
+/**
+ * @brief Освобождение отображения и дескриптора
+ */
+MappedKeySource::~MappedKeySource() {
+    if (map)
+        munmap(map, length);
+    if (fd >= 0)
+        ::close(fd);
+}
+
+/**
+ * @brief Открытие файла ключа
+ * @param [in] path Путь к файлу в UTF-8
+ * @param [in] chunk Размер фрагмента в байтах
+ * @throw cipher_error Если файл не удалось открыть
+ */
+ChunkedKeySource::ChunkedKeySource(const char* path, size_t chunk)
+    : fd(::open(path, O_RDONLY)), owned(true), buffer(std::max<size_t>(chunk, 8)) {
+    if (fd < 0)
+        throwCipherError("Cannot open key file");
+}
+
+/**
+ * @brief Источник по открытому дескриптору
+ * @param [in] descriptor Дескриптор файла или канала
+ * @param [in] chunk Размер фрагмента в байтах
+ */
+ChunkedKeySource::ChunkedKeySource(int descriptor, size_t chunk)
+    : fd(descriptor), buffer(std::max<size_t>(chunk, 8)) {}
+
+/**
+ * @brief Закрытие файла
+ */
+ChunkedKeySource::~ChunkedKeySource() {
+    if (owned && fd >= 0)
+        ::close(fd);
+}
+
+/**
+ * @brief Чтение следующего фрагмента
+ * @throw cipher_error При ошибке чтения
+ */
+void ChunkedKeySource::refill() {
+    std::memmove(buffer.data(), buffer.data() + begin, filled - begin);
+    filled -= begin;
+    begin = 0;
+    while (filled < buffer.size()) {
+        ssize_t r = ::read(fd, buffer.data() + filled, buffer.size() - filled);
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r < 0)
+            throwCipherError("Cannot read key file");
+        if (r == 0) {
+            eof = true;
+            return;
+        }
+        filled += static_cast<size_t>(r);
+    }
+}
+
+/**
+ * @brief Чтение очередных букв ключа
+ * @param [out] out Буфер для номеров букв
+ * @param [in] n Количество запрошенных букв
+ * @return Количество прочитанных букв
+ * @throw cipher_error При ошибке чтения
+ */
+size_t ChunkedKeySource::read(uint8_t* out, size_t n) {
+    size_t m = 0;
+    while (m < n) {
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(buffer.data());
+        const unsigned char* p = data + begin;
+        m += parseLetters(p, data + filled, out + m, n - m, eof);
+        begin = static_cast<size_t>(p - data);
+        if (m == n || eof)
+            break;
+        refill();
+    }
+    return m;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file modKeySource.h
+ * @brief Заголовочный файл источников бегущего ключа
+ * @details Источник выдает буквы ключа номерами 0..32 по одному байту
+ * последовательно, не храня весь ключ в памяти. Ключ читается из текста в
+ * UTF-8: русские буквы любого регистра, прочие символы пропускаются
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Источник букв бегущего ключа
+ */
+class KeySource {
+public:
+    virtual ~KeySource() = default;
+
+    /**
+     * @brief Чтение очередных букв ключа
+     * @param [out] out Буфер для номеров букв
+     * @param [in] n Количество запрошенных букв
+     * @return Количество прочитанных букв; меньше n только в конце ключа
+     */
+    virtual size_t read(uint8_t* out, size_t n) = 0;
+};
+
+/**
+ * @brief Ключ из текста в памяти
+ * @details Текст не копируется и должен существовать, пока используется источник
+ */
+class MemoryKeySource : public KeySource {
+protected:
+    const unsigned char* pos = nullptr; /// Текущая позиция в тексте
+    const unsigned char* end = nullptr; /// Конец текста
+
+    /**
+     * @brief Пустой источник для производных классов
+     */
+    MemoryKeySource() = default;
+
+public:
+    /**
+     * @brief Источник по тексту в UTF-8
+     * @param [in] text Текст ключа
+     */
+    explicit MemoryKeySource(std::string_view text);
+
+    /**
+     * @brief Чтение очередных букв ключа
+     * @param [out] out Буфер для номеров букв
+     * @param [in] n Количество запрошенных букв
+     * @return Количество прочитанных букв
+     */
+    size_t read(uint8_t* out, size_t n) override;
+};
+
+/**
+ * @brief Ключ из файла, отображенного в память
+ * @details Страницы файла подгружаются системой по мере чтения, поэтому
+ * ключ любой длины не занимает памяти процесса
+ */
+class MappedKeySource : public MemoryKeySource {
+private:
+    int fd = -1;           /// Дескриптор файла
+    void* map = nullptr;   /// Начало отображения
+    size_t length = 0;     /// Размер отображения
+
+public:
+    /**
+     * @brief Отображение файла ключа
+     * @param [in] path Путь к файлу в UTF-8
+     * @throw cipher_error Если файл не удалось открыть или отобразить
+     */
+    explicit MappedKeySource(const char* path);
+
+    MappedKeySource(const MappedKeySource&) = delete;
+    MappedKeySource& operator=(const MappedKeySource&) = delete;
+
+    /**
+     * @brief Освобождение отображения и дескриптора
+     */
+    ~MappedKeySource() override;
+};
+
+/**
+ * @brief Ключ из файла, читаемого фрагментами
+ * @details Подходит для каналов и файлов, которые нельзя отобразить;
+ * в памяти хранится один фрагмент
+ */
+class ChunkedKeySource : public KeySource {
+private:
+    int fd = -1;              /// Дескриптор файла
+    bool owned = false;       /// Дескриптор закрывается источником
+    bool eof = false;         /// Файл прочитан до конца
+    std::vector<char> buffer; /// Фрагмент файла
+    size_t begin = 0;         /// Начало непрочитанной части фрагмента
+    size_t filled = 0;        /// Конец данных во фрагменте
+
+    /**
+     * @brief Чтение следующего фрагмента
+     * @details Непрочитанный остаток переносится в начало буфера
+     * @throw cipher_error При ошибке чтения
+     */
+    void refill();
+
+public:
+    /**
+     * @brief Открытие файла ключа
+     * @param [in] path Путь к файлу в UTF-8
+     * @param [in] chunk Размер фрагмента в байтах
+     * @throw cipher_error Если файл не удалось открыть
+     */
+    explicit ChunkedKeySource(const char* path, size_t chunk = 1 << 16);
+
+    /**
+     * @brief Источник по открытому дескриптору
+     * @details Дескриптор не закрывается источником
+     * @param [in] descriptor Дескриптор файла или канала
+     * @param [in] chunk Размер фрагмента в байтах
+     */
+    explicit ChunkedKeySource(int descriptor, size_t chunk = 1 << 16);
+
+    ChunkedKeySource(const ChunkedKeySource&) = delete;
+    ChunkedKeySource& operator=(const ChunkedKeySource&) = delete;
+
+    /**
+     * @brief Закрытие файла
+     */
+    ~ChunkedKeySource() override;
+
+    /**
+     * @brief Чтение очередных букв ключа
+     * @param [out] out Буфер для номеров букв
+     * @param [in] n Количество запрошенных букв
+     * @return Количество прочитанных букв
+     * @throw cipher_error При ошибке чтения
+     */
+    size_t read(uint8_t* out, size_t n) override;
+};
@@ -0,0 +1,124 @@
+/**
+ * @file modRunningKey.cpp
+ * @brief Реализация класса modRunningKeyCipher
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include "modRunningKey.h"
+#include <algorithm>
+#include "../common/modAlphabet.h"
+#include "../common/modCipherError.h"
+#include "../common/modNormalize.h"
+#include "modShiftKernel.h"
+
+/**
+ * @brief Конструктор по источнику ключа
+ * @param [in] key Источник букв ключа
+ */
+modRunningKeyCipher::modRunningKeyCipher(KeySource& key) : source(key) {}
+
+/**
+ * @brief Сдвиг блока на очередные буквы ключа
+ * @details Блок ключа используется ядром сдвига как ключ длиной m с
+ * фазы 0, поэтому каждая буква сдвигается на свою букву ключа
+ * @param [in,out] work Номера букв блока
+ * @param [in] m Количество букв
+ * @param [in] inverse Обратный сдвиг для дешифрования
+ * @throw cipher_error Если ключ закончился
+ */
+void modRunningKeyCipher::shiftBlock(uint8_t* work, size_t m, bool inverse) {
+    if (m == 0)
+        return;
+    uint8_t key[blockSize];
+    size_t got = source.read(key, m);
+    used += got;
+    if (got < m)
+        throwCipherError("Key too short");
+    if (inverse) {
+        for (size_t j = 0; j < m; ++j)
+            key[j] = static_cast<uint8_t>(key[j] ? Alphabet::size - key[j] : 0);
+    }
+    shiftIndices(work, m, key, m, 0);
+}
+
+/**
+ * @brief Шифрование открытого текста
+ * @param [in] open_text Открытый текст для шифрования
+ * @return Зашифрованный текст
+ * @throw cipher_error Если текст не содержит букв или ключ короче текста
+ */
+std::wstring modRunningKeyCipher::encrypt(const std::wstring& open_text) {
+    std::wstring result(open_text.size(), L'\0');
+    uint8_t work[blockSize];
+    size_t pos = 0;
+    size_t n = 0;
+    while (pos < open_text.size()) {
+        size_t step = std::min(blockSize, open_text.size() - pos);
+        size_t m = Normalize::indices(open_text.data() + pos, step, work);
+        pos += step;
+        shiftBlock(work, m, false);
+        for (size_t j = 0; j < m; ++j)
+            result[n + j] = Alphabet::letter(work[j]);
+        n += m;
+    }
+    if (n == 0)
+        throwCipherError("Empty text, no letters");
+    result.resize(n);
+    return result;
+}
+
+/**
+ * @brief Дешифрование зашифрованного текста
+ * @param [in] cipher_text Зашифрованный текст для дешифрования
+ * @return Расшифрованный текст
+ * @throw cipher_error Если текст невалиден или ключ короче текста
+ */
+std::wstring modRunningKeyCipher::decrypt(const std::wstring& cipher_text) {
+    if (cipher_text.empty())
+        throwCipherError("Empty cipher text");
+    // Текст проверяется целиком до чтения ключа, чтобы ошибка в тексте не сдвигала ключ
+    if (Normalize::findNonUpper(cipher_text.data(), cipher_text.size()) != cipher_text.size())
+        throwCipherError("Incorrect data entry");
+    std::wstring result(cipher_text.size(), L'\0');
+    uint8_t work[blockSize];
+    for (size_t start = 0; start < cipher_text.size(); start += blockSize) {
+        size_t m = std::min(blockSize, cipher_text.size() - start);
+        Normalize::upperIndices(cipher_text.data() + start, m, work);
+        shiftBlock(work, m, true);
+        for (size_t j = 0; j < m; ++j)
+            result[start + j] = Alphabet::letter(work[j]);
+    }
+    return result;
+}
+
+/**
+ * @brief Шифрование текста из номеров букв
+ * @param [in] open_text Открытый текст
+ * @return Зашифрованный текст
+ * @throw cipher_error Если текст пустой или ключ короче текста
+ */
+IndexedText modRunningKeyCipher::encrypt(const IndexedText& open_text) {
+    if (open_text.empty())
+        throwCipherError("Empty text, no letters");
+    IndexedText result(open_text);
+    for (size_t start = 0; start < result.size(); start += blockSize)
+        shiftBlock(result.idx.data() + start, std::min(blockSize, result.size() - start), false);
+    return result;
+}
+
+/**
+ * @brief Дешифрование текста из номеров букв
+ * @param [in] cipher_text Зашифрованный текст
+ * @return Расшифрованный текст
+ * @throw cipher_error Если текст пустой или ключ короче текста
+ */
+IndexedText modRunningKeyCipher::decrypt(const IndexedText& cipher_text) {
+    if (cipher_text.empty())
+        throwCipherError("Empty cipher text");
+    IndexedText result(cipher_text);
+    for (size_t start = 0; start < result.size(); start += blockSize)
+        shiftBlock(result.idx.data() + start, std::min(blockSize, result.size() - start), true);
+    return result;
+}
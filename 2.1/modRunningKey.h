@@ -0,0 +1,86 @@
+/**
+ * @file modRunningKey.h
+ * @brief Заголовочный файл для класса modRunningKeyCipher
+ * @details Шифр Гронсфельда с бегущим ключом длиной с сообщение
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <string>
+#include "../common/modIndexedText.h"
+#include "modKeySource.h"
+
+/**
+ * @brief Класс шифрования бегущим ключом
+ * @details Каждая буква текста сдвигается на очередную букву ключа из
+ * KeySource. Ключ читается блоками синхронно с текстом и не хранится
+ * целиком; повторные вызовы продолжают ключ с места, где остановился
+ * предыдущий. Результат совпадает с modAlphaCipher, ключ которого равен
+ * соответствующему участку бегущего ключа
+ */
+class modRunningKeyCipher {
+private:
+    KeySource& source; /// Источник букв ключа
+    size_t used = 0;   /// Количество использованных букв ключа
+
+    /// Размер блока текста и ключа, обрабатываемого за раз
+    static constexpr size_t blockSize = 4096;
+
+    /**
+     * @brief Сдвиг блока на очередные буквы ключа
+     * @param [in,out] work Номера букв блока
+     * @param [in] m Количество букв
+     * @param [in] inverse Обратный сдвиг для дешифрования
+     * @throw cipher_error Если ключ закончился
+     */
+    void shiftBlock(uint8_t* work, size_t m, bool inverse);
+
+public:
+    /**
+     * @brief Конструктор по источнику ключа
+     * @details Источник должен существовать, пока используется шифратор
+     * @param [in] key Источник букв ключа
+     */
+    explicit modRunningKeyCipher(KeySource& key);
+
+    /**
+     * @brief Шифрование открытого текста
+     * @param [in] open_text Открытый текст для шифрования
+     * @return Зашифрованный текст
+     * @throw cipher_error Если текст не содержит букв или ключ короче текста;
+     * после нехватки ключа позиция в нем не определена
+     */
+    std::wstring encrypt(const std::wstring& open_text);
+
+    /**
+     * @brief Дешифрование зашифрованного текста
+     * @param [in] cipher_text Зашифрованный текст для дешифрования
+     * @return Расшифрованный текст
+     * @throw cipher_error Если текст невалиден или ключ короче текста
+     */
+    std::wstring decrypt(const std::wstring& cipher_text);
+
+    /**
+     * @brief Шифрование текста из номеров букв
+     * @param [in] open_text Открытый текст
+     * @return Зашифрованный текст
+     * @throw cipher_error Если текст пустой или ключ короче текста
+     */
+    IndexedText encrypt(const IndexedText& open_text);
+
+    /**
+     * @brief Дешифрование текста из номеров букв
+     * @param [in] cipher_text Зашифрованный текст
+     * @return Расшифрованный текст
+     * @throw cipher_error Если текст пустой или ключ короче текста
+     */
+    IndexedText decrypt(const IndexedText& cipher_text);
+
+    /**
+     * @brief Количество использованных букв ключа
+     * @return Число букв ключа, прочитанных с момента создания
+     */
+    size_t consumed() const noexcept { return used; }
+};
@@ -0,0 +1,236 @@
+/**
+ * @file modShiftKernel.cpp
+ * @brief Реализация ядра сдвига шифра Гронсфельда
+ * @details Содержит скалярную, AVX2, AVX-512 и NEON реализации сдвига и
+ * их выбор во время выполнения
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include "modShiftKernel.h"
+#include "../common/modAlphabet.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SHIFT_KERNEL_X86 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SHIFT_KERNEL_NEON 1
+#endif
+
+namespace {
+
+/// Тип функции ядра
+using ShiftFn = size_t (*)(uint8_t*, size_t, const uint8_t*, size_t, size_t);
+
+/**
+ * @brief Скалярный сдвиг короткого участка без смены фазы
+ * @param [in,out] d Номера букв
+ * @param [in] k Сдвиги, начиная с текущей фазы
+ * @param [in] m Количество номеров (не больше shiftKernelWidth)
+ */
+inline void shiftTail(uint8_t* d, const uint8_t* k, size_t m) {
+    for (size_t i = 0; i < m; ++i) {
+        unsigned v = d[i] + k[i];
+        d[i] = static_cast<uint8_t>(v >= Alphabet::size ? v - Alphabet::size : v);
+    }
+}
+
+/**
+ * @brief Скалярная реализация ядра
+ */
+size_t shiftScalar(uint8_t* d, size_t n, const uint8_t* s, size_t keySize, size_t phase) {
+    while (n >= shiftKernelWidth) {
+        shiftTail(d, s + phase, shiftKernelWidth);
+        d += shiftKernelWidth;
+        n -= shiftKernelWidth;
+        phase = (phase + shiftKernelWidth) % keySize;
+    }
+    shiftTail(d, s + phase, n);
+    return (phase + n) % keySize;
+}
+
+#if defined(SHIFT_KERNEL_X86)
+/**
+ * @brief Реализация ядра на AVX2 (два 32-байтных регистра за шаг)
+ * @details min(x, x - 33) в беззнаковой арифметике заменяет x % 33 для x < 66
+ */
+__attribute__((target("avx2")))
+size_t shiftAvx2(uint8_t* d, size_t n, const uint8_t* s, size_t keySize, size_t phase) {
+    const __m256i m = _mm256_set1_epi8(static_cast<char>(Alphabet::size));
+    while (n >= shiftKernelWidth) {
+        const uint8_t* k = s + phase;
+        __m256i a = _mm256_add_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(d)),
+                                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(k)));
+        __m256i b = _mm256_add_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + 32)),
+                                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(k + 32)));
+        a = _mm256_min_epu8(a, _mm256_sub_epi8(a, m));
+        b = _mm256_min_epu8(b, _mm256_sub_epi8(b, m));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), a);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 32), b);
+        d += shiftKernelWidth;
+        n -= shiftKernelWidth;
+        phase = (phase + shiftKernelWidth) % keySize;
+    }
+    shiftTail(d, s + phase, n);
+    return (phase + n) % keySize;
+}
+
+/**
+ * @brief Реализация ядра на AVX-512BW (один 64-байтный регистр за шаг)
+ */
+__attribute__((target("avx512f,avx512bw")))
+size_t shiftAvx512(uint8_t* d, size_t n, const uint8_t* s, size_t keySize, size_t phase) {
+    const __m512i m = _mm512_set1_epi8(static_cast<char>(Alphabet::size));
+    while (n >= shiftKernelWidth) {
+        __m512i a = _mm512_add_epi8(_mm512_loadu_si512(d), _mm512_loadu_si512(s + phase));
+        a = _mm512_min_epu8(a, _mm512_sub_epi8(a, m));
+        _mm512_storeu_si512(d, a);
+        d += shiftKernelWidth;
+        n -= shiftKernelWidth;
+        phase = (phase + shiftKernelWidth) % keySize;
+    }
+    shiftTail(d, s + phase, n);
+    return (phase + n) % keySize;
+}
+#endif
+
+#if defined(SHIFT_KERNEL_NEON)
+/**
+ * @brief Реализация ядра на NEON (четыре 16-байтных регистра за шаг)
+ */
+size_t shiftNeon(uint8_t* d, size_t n, const uint8_t* s, size_t keySize, size_t phase) {
+    const uint8x16_t m = vdupq_n_u8(Alphabet::size);
+    while (n >= shiftKernelWidth) {
+        const uint8_t* k = s + phase;
+        for (size_t j = 0; j < shiftKernelWidth; j += 16) {
+            uint8x16_t a = vaddq_u8(vld1q_u8(d + j), vld1q_u8(k + j));
+            vst1q_u8(d + j, vminq_u8(a, vsubq_u8(a, m)));
+        }
+        d += shiftKernelWidth;
+        n -= shiftKernelWidth;
+        phase = (phase + shiftKernelWidth) % keySize;
+    }
+    shiftTail(d, s + phase, n);
+    return (phase + n) % keySize;
+}
+#endif
+
+/**
+ * @brief Описание выбранной реализации
+ */
+struct ShiftImpl {
+    ShiftFn fn;       ///< Функция ядра
+    const char* name; ///< Название реализации
+};
+
+/**
+ * @brief Выбор реализации по возможностям процессора
+ * @return Лучшая доступная реализация
+ */
+ShiftImpl selectShift() {
+#if defined(SHIFT_KERNEL_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw"))
+        return {shiftAvx512, "avx512"};
+    if (__builtin_cpu_supports("avx2"))
+        return {shiftAvx2, "avx2"};
+#elif defined(SHIFT_KERNEL_NEON)
+    return {shiftNeon, "neon"};
+#endif
+    return {shiftScalar, "scalar"};
+}
+
+/**
+ * @brief Реализация, выбранная при первом обращении
+ */
+const ShiftImpl& shiftImpl() {
+    static const ShiftImpl impl = selectShift();
+    return impl;
+}
+
+}
+
+/**
+ * @brief Построение развернутого ключевого потока
+ * @param [in] key Ключ в числовом виде
+ * @param [in] inverse Построить поток обратных сдвигов
+ * @return Развернутый поток длиной key.size() + shiftKernelWidth
+ */
+std::vector<uint8_t> shiftKeyStream(const std::vector<int>& key, bool inverse) {
+    std::vector<uint8_t> stream(key.size() + shiftKernelWidth);
+    for (size_t i = 0; i < stream.size(); ++i) {
+        int k = key[i % key.size()];
+        stream[i] = static_cast<uint8_t>(inverse ? (Alphabet::size - k) % Alphabet::size : k);
+    }
+    return stream;
+}
+
+/**
+ * @brief Сдвиг номеров букв по модулю размера алфавита
+ * @param [in,out] data Номера букв 0..32
+ * @param [in] n Количество номеров
+ * @param [in] stream Развернутый ключевой поток
+ * @param [in] keySize Длина исходного ключа
+ * @param [in] phase Позиция в ключе для data[0]
+ * @return Позиция в ключе для следующего символа
+ */
+size_t shiftIndices(uint8_t* data, size_t n, const uint8_t* stream, size_t keySize, size_t phase) {
+    return shiftImpl().fn(data, n, stream, keySize, phase);
+}
+
+/**
+ * @brief Название выбранной реализации ядра
+ * @return Название реализации
+ */
+const char* shiftKernelName() {
+    return shiftImpl().name;
+}
+
+/**
+ * @brief Наличие векторной реализации ядра
+ * @return true, если выбрана не скалярная реализация
+ */
+bool shiftKernelVectorized() {
+    return shiftImpl().fn != shiftScalar;
+}
+
+/**
+ * @brief Построение таблицы подстановок по позициям ключа
+ * @param [in] key Ключ в числовом виде
+ * @param [in] inverse Построить таблицу обратных сдвигов
+ * @return Таблица размером key.size() x 33
+ */
+std::vector<uint8_t> shiftKeyTable(const std::vector<int>& key, bool inverse) {
+    std::vector<uint8_t> table(key.size() * Alphabet::size);
+    for (size_t j = 0; j < key.size(); ++j) {
+        int k = inverse ? (Alphabet::size - key[j]) % Alphabet::size : key[j];
+        for (int i = 0; i < Alphabet::size; ++i) {
+            table[j * Alphabet::size + i] = static_cast<uint8_t>((i + k) % Alphabet::size);
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Сдвиг номеров букв по таблице подстановок
+ * @param [in,out] data Номера букв 0..32
+ * @param [in] n Количество номеров
+ * @param [in] table Таблица подстановок
+ * @param [in] keySize Длина исходного ключа
+ * @param [in] phase Позиция в ключе для data[0]
+ * @return Позиция в ключе для следующего символа
+ */
+size_t shiftTable(uint8_t* data, size_t n, const uint8_t* table, size_t keySize, size_t phase) noexcept {
+    const uint8_t* row = table + phase * Alphabet::size;
+    const uint8_t* end = table + keySize * Alphabet::size;
+    for (size_t i = 0; i < n; ++i) {
+        data[i] = row[data[i]];
+        row += Alphabet::size;
+        if (row == end) {
+            row = table;
+        }
+    }
+    return static_cast<size_t>(row - table) / Alphabet::size;
+}
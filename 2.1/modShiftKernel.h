@@ -0,0 +1,79 @@
+/**
+ * @file modShiftKernel.h
+ * @brief Заголовочный файл ядра сдвига шифра Гронсфельда
+ * @details Сдвиг номеров букв на повторяющийся ключ в 8-битных дорожках.
+ * Реализация (AVX-512, AVX2, NEON или скалярная) выбирается во время
+ * выполнения по возможностям процессора
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Количество символов, обрабатываемых ядром за один шаг
+constexpr size_t shiftKernelWidth = 64;
+
+/**
+ * @brief Построение развернутого ключевого потока
+ * @details Ключ повторяется так, чтобы с любой фазы 0..key.size()-1
+ * можно было прочитать shiftKernelWidth сдвигов подряд
+ * @param [in] key Ключ в числовом виде (номера букв 0..32)
+ * @param [in] inverse Построить поток обратных сдвигов для дешифрования
+ * @return Развернутый поток длиной key.size() + shiftKernelWidth
+ */
+std::vector<uint8_t> shiftKeyStream(const std::vector<int>& key, bool inverse);
+
+/**
+ * @brief Сдвиг номеров букв по модулю размера алфавита
+ * @details data[i] = (data[i] + stream[(phase + i) % keySize]) mod 33,
+ * где вместо деления используется сравнение с вычитанием
+ * @param [in,out] data Номера букв 0..32
+ * @param [in] n Количество номеров
+ * @param [in] stream Развернутый ключевой поток из shiftKeyStream()
+ * @param [in] keySize Длина исходного ключа
+ * @param [in] phase Позиция в ключе для data[0]
+ * @return Позиция в ключе для символа, следующего за data[n - 1]
+ */
+size_t shiftIndices(uint8_t* data, size_t n, const uint8_t* stream, size_t keySize, size_t phase);
+
+/**
+ * @brief Название выбранной реализации ядра
+ * @return "avx512", "avx2", "neon" или "scalar"
+ */
+const char* shiftKernelName();
+
+/**
+ * @brief Наличие векторной реализации ядра
+ * @return true, если выбрана не скалярная реализация
+ */
+bool shiftKernelVectorized();
+
+/// Наибольший размер таблицы подстановок одного направления, байт (половина L1)
+constexpr size_t shiftTableLimit = 16384;
+
+/**
+ * @brief Построение таблицы подстановок по позициям ключа
+ * @details Строка j таблицы - готовые номера (i + key[j]) mod 33 для всех
+ * 33 номеров i, так что сдвиг буквы сводится к одному чтению
+ * @param [in] key Ключ в числовом виде (номера букв 0..32)
+ * @param [in] inverse Построить таблицу обратных сдвигов для дешифрования
+ * @return Таблица размером key.size() x 33
+ */
+std::vector<uint8_t> shiftKeyTable(const std::vector<int>& key, bool inverse);
+
+/**
+ * @brief Сдвиг номеров букв по таблице подстановок
+ * @details data[i] = table[((phase + i) % keySize) * 33 + data[i]]; строка
+ * таблицы сдвигается указателем, без деления по модулю
+ * @param [in,out] data Номера букв 0..32
+ * @param [in] n Количество номеров
+ * @param [in] table Таблица из shiftKeyTable()
+ * @param [in] keySize Длина исходного ключа
+ * @param [in] phase Позиция в ключе для data[0]
+ * @return Позиция в ключе для символа, следующего за data[n - 1]
+ */
+size_t shiftTable(uint8_t* data, size_t n, const uint8_t* table, size_t keySize, size_t phase) noexcept;
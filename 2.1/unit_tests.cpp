@@ -9,10 +9,20 @@
 
 #include <UnitTest++/UnitTest++.h>
 #include "modAlphaCipher.h"
+#include "modAlphaCipherFixed.h"
+#include "modAlphaStream.h"
+#include "modRunningKey.h"
 #include <iostream>
 #include <locale>
 #include <codecvt>
+#include <cwctype>
+#include <memory_resource>
 #include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+#include <unistd.h>
 
 using namespace std;
 
@@ -82,6 +92,55 @@ SUITE(KeyTest)
         CHECK_EQUAL_WS(L"МИРМИ", modAlphaCipher(L"МИР").encrypt(L"ААААА"));
     }
     
+    /**
+     * @brief Тест смены ключа
+     * @details После rekey() результат совпадает с новым шифратором,
+     * а невалидный ключ не меняет прежний
+     */
+    TEST(Rekey) {
+        modAlphaCipher cipher(L"МИР");
+        cipher.rekey(L"ключ");
+        CHECK_EQUAL_WS(modAlphaCipher(L"КЛЮЧ").encrypt(L"ПРИВЕТМИР"), cipher.encrypt(L"ПРИВЕТМИР"));
+        CHECK_THROW(cipher.rekey(L"КЛ1Ч"), cipher_error);
+        CHECK_EQUAL_WS(L"КЛЮЧК", cipher.encrypt(L"ААААА"));
+    }
+    
+    /**
+     * @brief Тест вытеснения из кэша подготовленных ключей
+     * @details Ключей больше емкости кэша; повторно подготовленный ключ
+     * дает тот же результат
+     */
+    TEST(ScheduleCacheEviction) {
+        const wstring alpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+        modAlphaCipher cipher(L"Я");
+        for (size_t i = 0; i < 2 * modAlphaCipher::scheduleCacheSize; ++i) {
+            cipher.rekey(wstring(1, alpha[i % 33]) + alpha[i / 33]);
+        }
+        cipher.rekey(L"Я");
+        CHECK_EQUAL_WS(L"ЯЯЯ", cipher.encrypt(L"ААА"));
+    }
+    
+    /**
+     * @brief Тест ограничения кэша подготовленных ключей по размеру
+     * @details Ключ больше предела записи не кэшируется; при превышении
+     * суммарного размера вытесняется давно не использованный ключ
+     */
+    TEST(ScheduleCacheBytes) {
+        KeyScheduleCache probe(0, 0, 0);
+        const size_t small = probe.get(L"МИР")->bytes();
+        KeyScheduleCache cache(8, 2 * small, small);
+        auto mir = cache.get(L"МИР");
+        CHECK(cache.get(L"МИР") == mir);
+        const wstring big(100, L'Я');
+        CHECK(cache.get(big) != cache.get(big));
+        CHECK_EQUAL_WS(big, cache.get(big)->text);
+        auto key = cache.get(L"КЛЮ");
+        auto bag = cache.get(L"БАГ");
+        CHECK(cache.get(L"БАГ") == bag);
+        CHECK(cache.get(L"КЛЮ") == key);
+        CHECK(cache.get(L"МИР") != mir);
+    }
+    
     /**
      * @brief Тест длинного ключа
      * @details Проверяет работу с ключом длиннее текста
@@ -130,6 +189,14 @@ SUITE(KeyTest)
         CHECK_THROW(modAlphaCipher cp(L""), cipher_error);
     }
     
+    /**
+     * @brief Тест ключа с латинскими буквами
+     * @details Проверяет возбуждение исключения при буквах не из русского алфавита
+     */
+    TEST(LatinKey) {
+        CHECK_THROW(modAlphaCipher cp(L"KEY"), cipher_error);
+    }
+    
     /**
      * @brief Тест слабого ключа
      * @details Проверяет работу с ключом из одинаковых символов
@@ -203,6 +270,65 @@ SUITE(EncryptTest)
     TEST(MaxShiftKey) {
         CHECK_EQUAL_WS(L"ОПЗБДС", modAlphaCipher(L"Я").encrypt(L"ПРИВЕТ"));
     }
+    
+    /**
+     * @brief Тест шифрования строки с буквой "ё"
+     * @details Проверяет приведение "ё" к "Ё" и её номер в алфавите
+     */
+    TEST_FIXTURE(KeyV_fixture, YoLetter) {
+        CHECK_EQUAL_WS(L"ЗИ", p->encrypt(L"ёЖ"));
+    }
+    
+    /**
+     * @brief Тест шифрования в буфер вызывающей стороны
+     * @details Проверяет количество записанных символов и их значение
+     */
+    TEST_FIXTURE(KeyV_fixture, EncryptIntoBuffer) {
+        wchar_t buf[16];
+        size_t n = p->encryptInto(L"ПРИВЕТ, МИР!", buf, 16);
+        CHECK_EQUAL(9u, n);
+        CHECK_EQUAL_WS(L"СТКДЖФОКТ", wstring(buf, n));
+    }
+    
+    /**
+     * @brief Тест шифрования в слишком маленький буфер
+     * @details Проверяет возбуждение исключения при нехватке места
+     */
+    TEST_FIXTURE(KeyV_fixture, EncryptIntoSmallBuffer) {
+        wchar_t buf[3];
+        CHECK_THROW(p->encryptInto(L"ПРИВЕТ", buf, 3), cipher_error);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования ядра сдвига
+ * @details Сравнивает векторное ядро с формулой сдвига на длинных текстах
+ */
+SUITE(KernelTest)
+{
+    /**
+     * @brief Тест совпадения с формулой для разных длин текста и ключа
+     * @details Охватывает неполные блоки ядра и смену фазы ключа
+     */
+    TEST(MatchesReference) {
+        const wstring alpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+        for (size_t keyLen : {1u, 2u, 7u, 33u, 63u, 64u, 65u, 130u}) {
+            wstring key;
+            for (size_t i = 0; i < keyLen; ++i)
+                key += alpha[(i * 5 + 3) % 33];
+            modAlphaCipher cipher(key);
+            for (size_t len : {1u, 63u, 64u, 65u, 200u, 5000u}) {
+                wstring text, expected;
+                for (size_t i = 0; i < len; ++i) {
+                    size_t t = (i * 7 + 1) % 33;
+                    text += alpha[t];
+                    expected += alpha[(t + (i % keyLen * 5 + 3) % 33) % 33];
+                }
+                CHECK_EQUAL_WS(expected, cipher.encrypt(text));
+                CHECK_EQUAL_WS(text, cipher.decrypt(expected));
+            }
+        }
+    }
 }
 
 /**
@@ -274,6 +400,771 @@ SUITE(DecryptTest)
     TEST(MaxShiftKey) {
         CHECK_EQUAL_WS(L"ПРИВЕТ", modAlphaCipher(L"Я").decrypt(L"ОПЗБДС"));
     }
+    
+    /**
+     * @brief Тест дешифрования в буфер вызывающей стороны
+     * @details Проверяет количество записанных символов и их значение
+     */
+    TEST_FIXTURE(KeyV_fixture, DecryptIntoBuffer) {
+        wchar_t buf[6];
+        size_t n = p->decryptInto(L"СТКДЖФ", buf, 6);
+        CHECK_EQUAL(6u, n);
+        CHECK_EQUAL_WS(L"ПРИВЕТ", wstring(buf, n));
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования потокового шифрования
+ * @details Проверяет перенос фазы ключа между фрагментами
+ */
+SUITE(StreamTest)
+{
+    /**
+     * @brief Тест шифрования по фрагментам
+     * @details Результат по фрагментам совпадает с шифрованием целиком
+     */
+    TEST(EncryptChunks) {
+        modAlphaCipher cipher(L"МИР");
+        modAlphaStream stream(cipher, modAlphaStream::Mode::Encrypt);
+        wstring result = stream.update(L"ПРИ");
+        result += stream.update(L"ВЕТ, ");
+        result += stream.update(L"123");
+        result += stream.update(L"мир");
+        CHECK_EQUAL_WS(cipher.encrypt(L"ПРИВЕТ, 123мир"), result);
+        CHECK_EQUAL(9u, stream.processed());
+    }
+    
+    /**
+     * @brief Тест дешифрования по фрагментам
+     * @details Результат по фрагментам совпадает с дешифрованием целиком
+     */
+    TEST(DecryptChunks) {
+        modAlphaCipher cipher(L"МИР");
+        wstring encrypted = cipher.encrypt(L"ПРИВЕТМИР");
+        modAlphaStream stream(cipher, modAlphaStream::Mode::Decrypt);
+        wstring result = stream.update(encrypted.substr(0, 4));
+        result += stream.update(encrypted.substr(4));
+        CHECK_EQUAL_WS(L"ПРИВЕТМИР", result);
+    }
+    
+    /**
+     * @brief Тест сброса потока
+     * @details После сброса шифрование начинается с начала ключа
+     */
+    TEST(Reset) {
+        modAlphaCipher cipher(L"МИР");
+        modAlphaStream stream(cipher, modAlphaStream::Mode::Encrypt);
+        stream.update(L"АА");
+        stream.reset();
+        CHECK_EQUAL_WS(L"МИР", stream.update(L"ААА"));
+        CHECK_EQUAL(3u, stream.processed());
+    }
+    
+    /**
+     * @brief Тест невалидного фрагмента шифротекста
+     * @details Проверяет возбуждение исключения при строчных буквах
+     */
+    TEST(InvalidCipherChunk) {
+        modAlphaStream stream(modAlphaCipher(L"МИР"), modAlphaStream::Mode::Decrypt);
+        CHECK_THROW(stream.update(L"АБв"), cipher_error);
+    }
+    
+    /**
+     * @brief Тест фрагментов в UTF-8, обработанных не по порядку
+     * @details Позиция каждого фрагмента задается seek() по числу букв
+     * предыдущих фрагментов
+     */
+    TEST(Utf8SeekChunks) {
+        modAlphaCipher cipher(L"КЛЮЧ");
+        const string parts[] = {"Привет, ", "123 ", "мир! Ёж"};
+        size_t offsets[3] = {0, 0, 0};
+        for (int i = 1; i < 3; ++i)
+            offsets[i] = offsets[i - 1] + modAlphaStream::countLetters(parts[i - 1]);
+        CHECK_EQUAL(6u, offsets[1]);
+        CHECK_EQUAL(6u, offsets[2]);
+        string out[3];
+        modAlphaStream stream(cipher, modAlphaStream::Mode::Encrypt);
+        for (int i : {2, 0, 1}) {
+            out[i].resize(parts[i].size());
+            stream.seek(offsets[i]);
+            out[i].resize(stream.update(parts[i], &out[i][0], out[i].size()));
+        }
+        string encrypted = out[0] + out[1] + out[2];
+        CHECK_EQUAL(cipher.encrypt(string_view("Привет, 123 мир! Ёж")), encrypted);
+        modAlphaStream back(cipher, modAlphaStream::Mode::Decrypt);
+        string tail = encrypted.substr(8);
+        string plain(tail.size(), '\0');
+        back.seek(4);
+        back.update(tail, &plain[0], plain.size());
+        CHECK_EQUAL(string("ЕТМИРЁЖ"), plain);
+        CHECK_EQUAL(11u, back.processed());
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования работы с UTF-8
+ * @details Проверяет шифрование без преобразования в wstring
+ */
+SUITE(Utf8Test)
+{
+    /**
+     * @brief Тест шифрования текста в UTF-8
+     * @details Проверяет фильтрацию ASCII и приведение регистра
+     */
+    TEST_FIXTURE(KeyV_fixture, Encrypt) {
+        CHECK_EQUAL(string("СТКДЖФОКТ"), p->encrypt(string_view("Привет, мир! 123")));
+    }
+    
+    /**
+     * @brief Тест дешифрования текста в UTF-8
+     * @details Проверяет совпадение с дешифрованием через wstring
+     */
+    TEST_FIXTURE(KeyV_fixture, Decrypt) {
+        CHECK_EQUAL(string("ПРИВЕТ"), p->decrypt(string_view("СТКДЖФ")));
+    }
+    
+    /**
+     * @brief Тест совпадения с шифрованием через wstring
+     * @details Проверяет букву "ё" и символы вне кириллицы
+     */
+    TEST(MatchesWide) {
+        modAlphaCipher cipher(L"МИР");
+        string text = "доброе утро, ёж — ça va €";
+        CHECK_EQUAL(wideToUtf8(cipher.encrypt(utf8ToWide(text))), cipher.encrypt(string_view(text)));
+    }
+    
+    /**
+     * @brief Тест дешифрования невалидного текста в UTF-8
+     * @details Проверяет возбуждение исключения при строчных буквах и ASCII
+     */
+    TEST_FIXTURE(KeyV_fixture, InvalidCipherText) {
+        CHECK_THROW(p->decrypt(string_view("СТКдЖФ")), cipher_error);
+        CHECK_THROW(p->decrypt(string_view("СТК ЖФ")), cipher_error);
+        CHECK_THROW(p->decrypt(string_view("")), cipher_error);
+    }
+    
+    /**
+     * @brief Тест шифрования текста в UTF-8 без русских букв
+     * @details Проверяет возбуждение исключения при пустом результате
+     */
+    TEST_FIXTURE(KeyV_fixture, NoLetters) {
+        CHECK_THROW(p->encrypt(string_view("hello, 123")), cipher_error);
+    }
+    
+    /**
+     * @brief Тест оборванных последовательностей UTF-8
+     * @details Ведущий байт трех- и четырехбайтового символа без байтов
+     * продолжения не должен поглощать следующую за ним букву
+     */
+    TEST(MalformedSequence) {
+        modAlphaCipher cipher(L"А");
+        CHECK_EQUAL(string("АБ"), cipher.encrypt(string_view("\xE2\xD0\x90\xD0\x91")));
+        CHECK_EQUAL(string("АБ"), cipher.encrypt(string_view("\xF0\x9F\xD0\x90\xD0\x91")));
+        CHECK_EQUAL(string("АБ"), cipher.encrypt(string_view("\xD0\xD0\x90\xBF\xD0\x91\xE2")));
+        CHECK(IndexedText::fromUtf8("\xE2\xD0\x90\xD0\x91") == IndexedText::fromOpenText(L"аб"));
+        MemoryKeySource key("\xE2\xD0\x90\xF0\xD0\x91");
+        uint8_t out[4];
+        CHECK_EQUAL(2u, key.read(out, 4));
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования параллельного режима
+ * @details Сравнивает параллельный режим с последовательным
+ */
+SUITE(ParallelTest)
+{
+    /**
+     * @brief Тест совпадения с последовательным шифрованием
+     * @details Текст с не-буквенными символами длиннее порога параллельного режима
+     */
+    TEST(MatchesSerial) {
+        modAlphaCipher cipher(L"ДЛИННЫЙКЛЮЧ");
+        wstring text;
+        for (size_t i = 0; text.size() < 3 * modAlphaCipher::parallelThreshold; ++i)
+            text += (i % 5 == 0) ? L"ёж, " : L"Привет";
+        wstring expected = cipher.encrypt(text);
+        for (unsigned threads : {2u, 3u, 7u}) {
+            wstring encrypted = cipher.encryptParallel(text, threads);
+            CHECK_EQUAL_WS(expected, encrypted);
+            CHECK_EQUAL_WS(cipher.decrypt(encrypted), cipher.decryptParallel(encrypted, threads));
+        }
+    }
+    
+    /**
+     * @brief Тест ошибки в одном из участков шифротекста
+     * @details Проверяет передачу исключения из рабочего потока
+     */
+    TEST(InvalidCipherText) {
+        modAlphaCipher cipher(L"МИР");
+        wstring text(2 * modAlphaCipher::parallelThreshold, L'А');
+        text[text.size() - 1] = L'а';
+        CHECK_THROW(cipher.decryptParallel(text, 4), cipher_error);
+    }
+    
+    /**
+     * @brief Тест длинного текста без букв
+     * @details Проверяет возбуждение исключения в параллельном режиме
+     */
+    TEST(NoLetters) {
+        modAlphaCipher cipher(L"МИР");
+        wstring text(2 * modAlphaCipher::parallelThreshold, L'1');
+        CHECK_THROW(cipher.encryptParallel(text, 4), cipher_error);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования шифра с ключом времени компиляции
+ * @details Сравнивает modAlphaCipherFixed с modAlphaCipher с тем же ключом
+ */
+SUITE(FixedTest)
+{
+    /**
+     * @brief Тест совпадения с шифром с ключом времени выполнения
+     * @details Длина текста не кратна ни длине ключа, ни размеру блока;
+     * длины ключей 4 и 1 делят ширину ядра, длина 3 - нет
+     */
+    TEST(MatchesRuntime) {
+        wstring text;
+        for (size_t i = 0; text.size() < 10007; ++i)
+            text += (i % 3 == 0) ? L"ёж, " : L"Привет";
+        modAlphaCipher runtime(L"КЛЮЧ");
+        modAlphaCipherFixed<L'К', L'Л', L'Ю', L'Ч'> fixed;
+        wstring encrypted = fixed.encrypt(text);
+        CHECK_EQUAL_WS(runtime.encrypt(text), encrypted);
+        CHECK_EQUAL_WS(runtime.decrypt(encrypted), fixed.decrypt(encrypted));
+        
+        modAlphaCipher single(L"в");
+        modAlphaCipherFixed<L'в'> fixedSingle;
+        CHECK_EQUAL_WS(single.encrypt(text), fixedSingle.encrypt(text));
+        
+        modAlphaCipher three(L"МИР");
+        modAlphaCipherFixed<L'М', L'И', L'Р'> fixedThree;
+        encrypted = fixedThree.encrypt(text);
+        CHECK_EQUAL_WS(three.encrypt(text), encrypted);
+        CHECK_EQUAL_WS(three.decrypt(encrypted), fixedThree.decrypt(encrypted));
+    }
+    
+    /**
+     * @brief Тест исключений для невалидного текста
+     */
+    TEST(SameValidation) {
+        modAlphaCipherFixed<L'М', L'И', L'Р'> fixed;
+        CHECK_THROW(fixed.encrypt(L"123 !"), cipher_error);
+        CHECK_THROW(fixed.decrypt(L""), cipher_error);
+        CHECK_THROW(fixed.decrypt(L"ПРИвет"), cipher_error);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования пакетной обработки
+ * @details Результаты пишутся в общий буфер, ошибки - по сообщениям
+ */
+SUITE(BatchTest)
+{
+    /**
+     * @brief Тест совпадения с поштучным шифрованием
+     */
+    TEST(MatchesSingle) {
+        modAlphaCipher cipher(L"КЛЮЧ");
+        vector<wstring_view> plains = {L"Привет, мир!", L"ААААА", L"ё", L"ДОБРЫЙ ВЕЧЕР"};
+        CipherBatch encrypted;
+        cipher.encryptBatch(plains.data(), plains.size(), encrypted);
+        CHECK_EQUAL(plains.size(), encrypted.size());
+        vector<wstring_view> ciphers;
+        for (size_t i = 0; i < plains.size(); ++i) {
+            CHECK(encrypted.status[i] == cipher_status::ok);
+            CHECK_EQUAL_WS(cipher.encrypt(wstring(plains[i])), wstring(encrypted.result(i)));
+            ciphers.push_back(encrypted.result(i));
+        }
+        CipherBatch decrypted;
+        cipher.decryptBatch(ciphers.data(), ciphers.size(), decrypted);
+        CHECK_EQUAL_WS(L"ПРИВЕТМИР", wstring(decrypted.result(0)));
+        CHECK_EQUAL_WS(L"ДОБРЫЙВЕЧЕР", wstring(decrypted.result(3)));
+    }
+    
+    /**
+     * @brief Тест состояния каждого сообщения пакета
+     * @details Невалидные сообщения не прерывают обработку остальных
+     */
+    TEST(PerSlotStatus) {
+        modAlphaCipher cipher(L"МИР");
+        vector<wstring_view> plains = {L"АБВ", L"123", L"ГДЕ"};
+        CipherBatch out;
+        cipher.encryptBatch(plains.data(), plains.size(), out);
+        CHECK(out.status[1] == cipher_status::empty_text);
+        CHECK(out.result(1).empty());
+        CHECK_EQUAL_WS(cipher.encrypt(L"ГДЕ"), wstring(out.result(2)));
+        vector<wstring_view> ciphers = {L"", L"МИр", L"МИР"};
+        cipher.decryptBatch(ciphers.data(), ciphers.size(), out);
+        CHECK_EQUAL(3u, out.size());
+        CHECK(out.status[0] == cipher_status::empty_text);
+        CHECK(out.status[1] == cipher_status::invalid_text);
+        CHECK(out.status[2] == cipher_status::ok);
+        CHECK_EQUAL_WS(cipher.decrypt(L"МИР"), wstring(out.result(2)));
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования выделения памяти из заданного источника
+ */
+SUITE(PmrTest)
+{
+    /**
+     * @brief Тест шифрования без обращения к общей куче
+     * @details Источник без резервного выделителя возбуждает bad_alloc,
+     * если памяти буфера не хватило
+     */
+    TEST(ArenaOnly) {
+        modAlphaCipher cipher(L"КЛЮЧ");
+        alignas(std::max_align_t) char buffer[4096];
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        std::pmr::wstring encrypted = cipher.encrypt(L"Привет, мир!", &arena);
+        CHECK_EQUAL_WS(cipher.encrypt(L"Привет, мир!"), wstring(encrypted));
+        std::pmr::wstring decrypted = cipher.decrypt(encrypted, &arena);
+        CHECK_EQUAL_WS(L"ПРИВЕТМИР", wstring(decrypted));
+    }
+    
+    /**
+     * @brief Тест исключений при заданном источнике памяти
+     */
+    TEST(InvalidText) {
+        modAlphaCipher cipher(L"МИР");
+        std::pmr::monotonic_buffer_resource arena;
+        CHECK_THROW(cipher.encrypt(L"123", &arena), cipher_error);
+        CHECK_THROW(cipher.decrypt(L"", &arena), cipher_error);
+        CHECK_THROW(cipher.decrypt(L"МИр", &arena), cipher_error);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования API без исключений
+ */
+SUITE(TryTest)
+{
+    /**
+     * @brief Тест совпадения с методами, возбуждающими исключения
+     */
+    TEST(MatchesThrowing) {
+        modAlphaCipher cipher(L"КЛЮЧ");
+        wstring out;
+        CHECK(cipher.tryEncrypt(L"Привет, мир!", out));
+        CHECK_EQUAL_WS(cipher.encrypt(L"Привет, мир!"), out);
+        wstring plain;
+        CHECK(cipher.tryDecrypt(out, plain));
+        CHECK_EQUAL_WS(L"ПРИВЕТМИР", plain);
+    }
+    
+    /**
+     * @brief Тест кода ошибки и позиции недопустимого символа
+     * @details Ошибка во втором блоке ядра сдвига
+     */
+    TEST(InvalidPosition) {
+        modAlphaCipher cipher(L"МИР");
+        wstring text(5000, L'А');
+        text[4321] = L'а';
+        wstring out;
+        cipher_result r = cipher.tryDecrypt(text, out);
+        CHECK(r.status == cipher_status::invalid_text);
+        CHECK_EQUAL(4321u, r.position);
+        CHECK(out.empty());
+        CHECK(cipher.tryDecrypt(L"", out).status == cipher_status::empty_text);
+        CHECK(cipher.tryEncrypt(L"123", out).status == cipher_status::empty_text);
+    }
+    
+    /**
+     * @brief Тест проверки ключа без исключений
+     */
+    TEST(CheckKey) {
+        CHECK(modAlphaCipher::checkKey(L"Ключ"));
+        CHECK(modAlphaCipher::checkKey(L"").status == cipher_status::invalid_key);
+        cipher_result r = modAlphaCipher::checkKey(L"КЛ1Ч");
+        CHECK(r.status == cipher_status::invalid_key);
+        CHECK_EQUAL(2u, r.position);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования счетчиков
+ */
+SUITE(StatsTest)
+{
+    /**
+     * @brief Тест счетчиков шифрования и отказов
+     * @details Без CIPHER_STATS счетчики не изменяются
+     */
+    TEST(Counters) {
+        CipherStatsSnapshot before = modAlphaCipher::stats().snapshot();
+        modAlphaCipher cipher(L"МИР");
+        wstring encrypted = cipher.encrypt(L"Привет, мир!");
+        CHECK_THROW(cipher.decrypt(L"ИТР РЕИ"), cipher_error);
+        CHECK_THROW(modAlphaCipher(L"КЛ1Ч"), cipher_error);
+        CipherStatsSnapshot after = modAlphaCipher::stats().snapshot();
+#if defined(CIPHER_STATS)
+        CHECK_EQUAL(12u, after.charsIn - before.charsIn);
+        CHECK_EQUAL(9u, after.lettersKept - before.lettersKept);
+        CHECK_EQUAL(3u, after.lettersDropped - before.lettersDropped);
+        CHECK_EQUAL(encrypted.size(), after.charsOut - before.charsOut);
+        size_t text = static_cast<size_t>(cipher_status::invalid_text);
+        size_t key = static_cast<size_t>(cipher_status::invalid_key);
+        CHECK_EQUAL(1u, after.rejected[text] - before.rejected[text]);
+        CHECK_EQUAL(1u, after.rejected[key] - before.rejected[key]);
+#else
+        CHECK_EQUAL(before.charsIn, after.charsIn);
+        CHECK_EQUAL(0u, after.charsOut);
+#endif
+    }
+    
+    /**
+     * @brief Тест счетчиков шифрования UTF-8
+     * @details Вход и выход учитываются в байтах, оставленные буквы - в буквах
+     */
+    TEST(Utf8Counters) {
+        CipherStatsSnapshot before = modAlphaCipher::stats().snapshot();
+        modAlphaCipher cipher(L"МИР");
+        std::string encrypted = cipher.encrypt(std::string("Привет, мир!"));
+        std::string decrypted = cipher.decrypt(encrypted);
+        std::string range = cipher.decryptRange(std::string_view(encrypted), 3, 3);
+        CHECK_THROW(cipher.encrypt(std::string("123")), cipher_error);
+        CHECK_THROW(cipher.decrypt(std::string("ИТР РЕИ")), cipher_error);
+        CHECK_THROW(cipher.decrypt(std::string("жж")), cipher_error);
+        CipherStatsSnapshot after = modAlphaCipher::stats().snapshot();
+#if defined(CIPHER_STATS)
+        CHECK_EQUAL(21u + 18u + 6u + 3u, after.charsIn - before.charsIn);
+        CHECK_EQUAL(9u + 9u + 3u, after.lettersKept - before.lettersKept);
+        CHECK_EQUAL(encrypted.size() + decrypted.size() + range.size(), after.charsOut - before.charsOut);
+        size_t empty = static_cast<size_t>(cipher_status::empty_text);
+        size_t text = static_cast<size_t>(cipher_status::invalid_text);
+        CHECK_EQUAL(1u, after.rejected[empty] - before.rejected[empty]);
+        CHECK_EQUAL(2u, after.rejected[text] - before.rejected[text]);
+#else
+        CHECK_EQUAL(before.charsIn, after.charsIn);
+        CHECK_EQUAL(0u, after.charsOut);
+#endif
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования однобайтового представления текста
+ */
+SUITE(IndexedTest)
+{
+    /**
+     * @brief Тест совпадения с шифрованием wstring
+     */
+    TEST(MatchesWide) {
+        modAlphaCipher cipher(L"КЛЮЧ");
+        wstring text(3 * 4096 + 17, L'ж');
+        text += L"Привет, мир!";
+        IndexedText encrypted = cipher.encrypt(IndexedText::fromOpenText(text));
+        CHECK_EQUAL_WS(cipher.encrypt(text), encrypted.toWide());
+        CHECK(IndexedText::fromCipherText(cipher.encrypt(text)) == encrypted);
+        CHECK_EQUAL_WS(cipher.decrypt(encrypted.toWide()), cipher.decrypt(encrypted).toWide());
+    }
+    
+    /**
+     * @brief Тест преобразований IndexedText
+     */
+    TEST(Conversions) {
+        IndexedText t = IndexedText::fromUtf8("Ёж, ель!");
+        CHECK_EQUAL(5u, t.size());
+        CHECK_EQUAL(6, t[0]);
+        CHECK_EQUAL_WS(L"ЁЖЕЛЬ", t.toWide());
+        CHECK_EQUAL(std::string("ЁЖЕЛЬ"), t.toUtf8());
+        CHECK(IndexedText::fromOpenText(L"ёж ель") == t);
+        CHECK_THROW(IndexedText::fromCipherText(L"ЁЖ ЕЛЬ"), cipher_error);
+    }
+    
+    /**
+     * @brief Тест пустого текста
+     */
+    TEST(EmptyText) {
+        modAlphaCipher cipher(L"МИР");
+        CHECK(IndexedText::fromOpenText(L"123").empty());
+        CHECK_THROW(cipher.encrypt(IndexedText::fromOpenText(L"123")), cipher_error);
+        CHECK_THROW(cipher.decrypt(IndexedText()), cipher_error);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования бегущего ключа
+ */
+SUITE(RunningKeyTest)
+{
+    /// Текст бегущего ключа в UTF-8
+    const std::string book = "Съешь же ещё этих мягких французских булок, да выпей чаю! 1234 The end.";
+    
+    /**
+     * @brief Тест совпадения с шифром Гронсфельда
+     * @details Ключ длиной с сообщение дает тот же результат, что и
+     * modAlphaCipher с этим ключом; повторный вызов продолжает ключ
+     */
+    TEST(MatchesAlpha) {
+        wstring key = IndexedText::fromUtf8(book).toWide();
+        wstring text = L"Привет, мир! Как дела?";
+        MemoryKeySource source(book);
+        modRunningKeyCipher cipher(source);
+        wstring first = cipher.encrypt(L"Привет, мир!");
+        wstring second = cipher.encrypt(L"Как дела?");
+        CHECK_EQUAL_WS(modAlphaCipher(key).encrypt(text), first + second);
+        CHECK_EQUAL(16u, cipher.consumed());
+        MemoryKeySource again(book);
+        modRunningKeyCipher back(again);
+        CHECK_EQUAL_WS(L"ПРИВЕТМИРКАКДЕЛА", back.decrypt(first + second));
+    }
+    
+    /**
+     * @brief Тест текста из номеров букв
+     */
+    TEST(Indexed) {
+        MemoryKeySource source(book);
+        modRunningKeyCipher cipher(source);
+        IndexedText text = IndexedText::fromOpenText(L"Ёлка и ёж");
+        IndexedText encrypted = cipher.encrypt(text);
+        MemoryKeySource again(book);
+        CHECK(modRunningKeyCipher(again).decrypt(encrypted) == text);
+    }
+    
+    /**
+     * @brief Тест ключа короче текста и невалидного текста
+     */
+    TEST(KeyTooShort) {
+        MemoryKeySource source("ключ");
+        modRunningKeyCipher cipher(source);
+        CHECK_THROW(cipher.encrypt(L"ПРИВЕТ"), cipher_error);
+        MemoryKeySource other("ключ");
+        modRunningKeyCipher plain(other);
+        CHECK_THROW(plain.decrypt(L"ПРИв"), cipher_error);
+        CHECK_EQUAL(0u, plain.consumed());
+        CHECK_THROW(plain.encrypt(L"123"), cipher_error);
+    }
+    
+    /**
+     * @brief Тест ключа из файла
+     * @details Отображенный файл и чтение фрагментами по 9 байт, обрывающими
+     * двухбайтовые буквы, дают те же буквы, что и текст в памяти
+     */
+    TEST(FileSources) {
+        char path[] = "/tmp/runningKeyXXXXXX";
+        int fd = mkstemp(path);
+        CHECK(fd >= 0);
+        CHECK_EQUAL(static_cast<ssize_t>(book.size()), write(fd, book.data(), book.size()));
+        close(fd);
+        std::vector<uint8_t> expected(200), mapped(200), chunked(200);
+        MemoryKeySource memory(book);
+        size_t n = memory.read(expected.data(), expected.size());
+        CHECK_EQUAL(IndexedText::fromUtf8(book).size(), n);
+        MappedKeySource map(path);
+        CHECK_EQUAL(n, map.read(mapped.data(), 5) + map.read(mapped.data() + 5, 195));
+        ChunkedKeySource file(path, 9);
+        CHECK_EQUAL(n, file.read(chunked.data(), 7) + file.read(chunked.data() + 7, 193));
+        CHECK(expected == mapped);
+        CHECK(expected == chunked);
+        unlink(path);
+        CHECK_THROW(MappedKeySource("/nonexistent/key"), cipher_error);
+        CHECK_THROW(ChunkedKeySource("/nonexistent/key"), cipher_error);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования дешифрования участка
+ */
+SUITE(RangeTest)
+{
+    /**
+     * @brief Тест совпадения с участком полного дешифрования
+     * @details Участки внутри блока, на границах блоков и в конце текста
+     */
+    TEST(MatchesDecrypt) {
+        const wstring alpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+        wstring text(10007, L'А');
+        for (size_t i = 0; i < text.size(); i++)
+            text[i] = alpha[(i * 7 + i / 33) % 33];
+        modAlphaCipher cipher(L"КЛЮЧИК");
+        wstring encrypted = cipher.encrypt(text);
+        string utf8 = wideToUtf8(encrypted);
+        for (size_t pos : {0u, 1u, 4095u, 4096u, 5000u, 10000u, 10007u}) {
+            for (size_t len : {0u, 1u, 7u, 5000u}) {
+                if (pos + len > text.size())
+                    continue;
+                CHECK(text.substr(pos, len) == cipher.decryptRange(encrypted, pos, len));
+                CHECK(wideToUtf8(text.substr(pos, len)) == cipher.decryptRange(string_view(utf8), pos, len));
+            }
+        }
+    }
+    
+    /**
+     * @brief Тест границ и проверки только прочитанных букв
+     */
+    TEST(Invalid) {
+        modAlphaCipher cipher(L"МИР");
+        wstring encrypted = cipher.encrypt(L"ПРИВЕТМИР");
+        CHECK_THROW(cipher.decryptRange(encrypted, 5, 5), cipher_error);
+        CHECK_THROW(cipher.decryptRange(encrypted, 10, 0), cipher_error);
+        CHECK_THROW(cipher.decryptRange(encrypted, 1, static_cast<size_t>(-1)), cipher_error);
+        encrypted[0] = L'a';
+        CHECK_THROW(cipher.decryptRange(encrypted, 0, 2), cipher_error);
+        CHECK_EQUAL_WS(L"ТМИР", cipher.decryptRange(encrypted, 5, 4));
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования векторной нормализации
+ */
+SUITE(NormalizeTest)
+{
+    /**
+     * @brief Тест совпадения номеров букв с Alphabet
+     * @details Текст длиннее блока шифрования и с буквами на границах векторов
+     */
+    TEST(Indices) {
+        wstring text;
+        for (size_t i = 0; i < 10000; i++)
+            text += static_cast<wchar_t>(0x3F0 + (i * 37) % 0x80);
+        vector<uint8_t> expected, idx(text.size());
+        for (wchar_t c : text)
+            if (Alphabet::index(c) >= 0)
+                expected.push_back(static_cast<uint8_t>(Alphabet::index(c)));
+        idx.resize(Normalize::indices(text.data(), text.size(), idx.data()));
+        CHECK(expected == idx);
+        modAlphaCipher cipher(L"КЛЮЧ");
+        wstring encrypted = cipher.encrypt(text);
+        CHECK_EQUAL(expected.size(), encrypted.size());
+        CHECK(encrypted.size() > 4097);
+        vector<uint8_t> upper(encrypted.size());
+        CHECK_EQUAL(encrypted.size(), Normalize::upperIndices(encrypted.data(), encrypted.size(), upper.data()));
+        encrypted[4097] = L'ъ';
+        CHECK_EQUAL(4097u, Normalize::upperIndices(encrypted.data(), encrypted.size(), upper.data()));
+        std::wstring out;
+        cipher_result r = cipher.tryDecrypt(encrypted, out);
+        CHECK(r.status == cipher_status::invalid_text);
+        CHECK_EQUAL(4097u, r.position);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования одновременного использования
+ */
+SUITE(ConcurrencyTest)
+{
+    /**
+     * @brief Тест общего объекта в нескольких потоках
+     * @details Потоки одновременно шифруют и дешифруют разными методами
+     * через константную ссылку на один объект; каждый результат
+     * сравнивается с вычисленным заранее в одном потоке
+     */
+    TEST(SharedInstance) {
+        const modAlphaCipher shared(L"КОНКУРЕНЦИЯ");
+        std::vector<wstring> texts;
+        for (size_t k = 0; k < 8; k++) {
+            wstring text;
+            for (size_t i = 0; i < 3000 + 1111 * k; i++)
+                text += (i % 9 == 0) ? L' ' : static_cast<wchar_t>(L'а' + (i * (k + 3)) % 32);
+            texts.push_back(text);
+        }
+        std::vector<wstring> expected;
+        for (const wstring& text : texts)
+            expected.push_back(shared.encrypt(text));
+        std::atomic<int> mismatches{0};
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < 8; t++) {
+            threads.emplace_back([&, t] {
+                for (size_t iter = 0; iter < 50; iter++) {
+                    size_t k = (t + iter) % texts.size();
+                    const wstring& plain = texts[k];
+                    const wstring& cipher = expected[k];
+                    bool ok = shared.encrypt(plain) == cipher;
+                    ok = ok && shared.decrypt(cipher) == shared.decrypt(shared.encrypt(plain));
+                    string utf8 = wideToUtf8(plain);
+                    ok = ok && shared.encrypt(string_view(utf8)) == wideToUtf8(cipher);
+                    IndexedText indexed = IndexedText::fromOpenText(plain);
+                    ok = ok && shared.decrypt(shared.encrypt(indexed)) == indexed;
+                    std::wstring out;
+                    ok = ok && shared.tryEncrypt(plain, out).status == cipher_status::ok && out == cipher;
+                    ok = ok && shared.decryptRange(cipher, 100, 50) == shared.decrypt(cipher).substr(100, 50);
+                    if (iter % 10 == 0)
+                        ok = ok && shared.encryptParallel(plain, 2) == cipher;
+                    if (!ok)
+                        mismatches++;
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        CHECK_EQUAL(0, mismatches.load());
+    }
+}
+
+/**
+ * @brief Набор тестов способов сдвига по ключу
+ * @details Проверяет, что таблица подстановок и векторное ядро дают
+ * одинаковый результат для всех видов текста
+ */
+SUITE(StrategyTest)
+{
+    /**
+     * @brief Сравнение способов на коротком и длинном ключе
+     */
+    TEST(SameResult) {
+        wstring text;
+        for (size_t i = 0; i < 20000; i++)
+            text += (i % 7 == 0) ? L' ' : static_cast<wchar_t>(L'а' + (i * 13) % 32);
+        wstring longKey;
+        for (size_t i = 0; i < 700; i++)
+            longKey += static_cast<wchar_t>(L'А' + (i * 5) % 32);
+        for (const wstring& key : {wstring(L"КЛЮЧ"), wstring(L"ЁЖИК"), longKey}) {
+            modAlphaCipher arithmetic(key, shift_strategy::arithmetic);
+            modAlphaCipher table(key, shift_strategy::table);
+            modAlphaCipher automatic(key);
+            wstring encrypted = arithmetic.encrypt(text);
+            CHECK(encrypted == table.encrypt(text));
+            CHECK(encrypted == automatic.encrypt(text));
+            CHECK(arithmetic.decrypt(encrypted) == table.decrypt(encrypted));
+            CHECK(encrypted == table.encryptParallel(text, 4));
+            CHECK(arithmetic.decrypt(encrypted) == table.decryptParallel(encrypted, 4));
+            string utf8 = wideToUtf8(text);
+            CHECK(arithmetic.encrypt(std::string_view(utf8)) == table.encrypt(std::string_view(utf8)));
+            IndexedText indexed = IndexedText::fromOpenText(text);
+            CHECK(arithmetic.encrypt(indexed) == table.encrypt(indexed));
+            CHECK(table.decrypt(table.encrypt(indexed)) == indexed);
+        }
+    }
+
+    /**
+     * @brief Выбор способа по длине ключа
+     * @details Для ключа длиннее shiftTableLimit / 33 таблица не строится
+     */
+    TEST(LongKeyFallsBack) {
+        CHECK(modAlphaCipher(L"КЛЮЧ", shift_strategy::table).shiftStrategy() == shift_strategy::table);
+        CHECK(modAlphaCipher(L"КЛЮЧ", shift_strategy::arithmetic).shiftStrategy() == shift_strategy::arithmetic);
+        wstring longKey(shiftTableLimit / Alphabet::size + 1, L'Б');
+        CHECK(modAlphaCipher(longKey, shift_strategy::table).shiftStrategy() == shift_strategy::arithmetic);
+        modAlphaCipher cipher(L"КЛЮЧ", shift_strategy::table);
+        cipher.rekey(longKey);
+        CHECK(cipher.shiftStrategy() == shift_strategy::arithmetic);
+        cipher.rekey(L"КЛЮЧ");
+        CHECK(cipher.shiftStrategy() == shift_strategy::table);
+    }
+
+    /**
+     * @brief Сдвиг по таблице с ненулевой фазы
+     */
+    TEST(TableKernel) {
+        std::vector<int> key = {3, 0, 32, 17, 6};
+        std::vector<uint8_t> stream = shiftKeyStream(key, false);
+        std::vector<uint8_t> table = shiftKeyTable(key, false);
+        std::vector<uint8_t> a(1000), b(1000);
+        for (size_t i = 0; i < a.size(); i++)
+            a[i] = b[i] = static_cast<uint8_t>((i * 7) % Alphabet::size);
+        size_t pa = shiftIndices(a.data(), a.size(), stream.data(), key.size(), 3);
+        size_t pb = shiftTable(b.data(), b.size(), table.data(), key.size(), 3);
+        CHECK(a == b);
+        CHECK_EQUAL(pa, pb);
+        std::vector<uint8_t> inverse = shiftKeyTable(key, true);
+        shiftTable(b.data(), b.size(), inverse.data(), key.size(), 3);
+        for (size_t i = 0; i < b.size(); i++)
+            CHECK_EQUAL((i * 7) % Alphabet::size, b[i]);
+    }
 }
 
 /**
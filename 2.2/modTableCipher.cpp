@@ -8,9 +8,9 @@
  */
 
 #include "modTableCipher.h"
+#include "modTranspose.h"
 #include <algorithm>
 #include <vector>
-#include <cwctype>
 
 using namespace std;
 
@@ -18,17 +18,29 @@ using namespace std;
  * @brief Валидация ключа шифрования
  * @param [in] key Ключ для проверки
  * @return Валидный ключ
- * @throw cipher_error Если ключ невалиден
+ * @throw cipher_error Если ключ невалиден или больше maxCols
  */
 int Table::getValidKey(const int key)
 {
+    if (checkKey(key, maxCols))
+        return key;
+    CIPHER_STATS_REJECT(stats(), cipher_status::invalid_key);
     if (key <= 0)
-        throw cipher_error("Invalid key: cannot be zero");
-    if (key < 0)
-        throw cipher_error("Invalid key: cannot be negative");
-    if (key > 100)
-        throw cipher_error("Invalid key: too large");
-    return key;
+        throwCipherError("Invalid key: cannot be zero");
+    throwCipherError("Invalid key: too large");
+}
+
+/**
+ * @brief Проверка ключа без исключений
+ * @param [in] key Количество столбцов
+ * @param [in] maxKey Наибольшее допустимое количество столбцов
+ * @return cipher_status::invalid_key или успешный результат
+ */
+cipher_result Table::checkKey(int key, int maxKey) noexcept
+{
+    if (key <= 0 || key > maxKey)
+        return {cipher_status::invalid_key, 0};
+    return {};
 }
 
 /**
@@ -39,50 +51,118 @@ int Table::getValidKey(const int key)
  */
 std::wstring Table::getValidOpenText(const std::wstring& s)
 {
-    std::wstring tmp;
-    std::wstring lower = L"абвгдеёжзийклмнопрстуфхцчшщъыьэюя";
-    std::wstring upper = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
-    
-    for (auto c : s) {
-        if (upper.find(c) != std::wstring::npos) {
-            tmp.push_back(c);
-        } else {
-            size_t pos = lower.find(c);
-            if (pos != std::wstring::npos) {
-                tmp.push_back(upper[pos]); 
-            }
-        }
+    std::wstring tmp(s.size(), L'\0');
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::validate);
+        tmp.resize(Normalize::letters(s.data(), s.size(), &tmp[0]));
+    }
+    CIPHER_STATS_INPUT(stats(), s.size(), tmp.size());
+    if (tmp.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty text: no valid Russian letters");
     }
-    if (tmp.empty())
-        throw cipher_error("Empty text: no valid Russian letters");
     return tmp;
 }
 
 /**
  * @brief Валидация зашифрованного текста
  * @param [in] s Зашифрованный текст для проверки
- * @return Валидный зашифрованный текст
+ * @return Ссылка на исходный текст, если он валиден
  * @throw cipher_error Если текст пустой или содержит не-прописные русские буквы
  */
-std::wstring Table::getValidCipherText(const std::wstring& s)
+const std::wstring& Table::getValidCipherText(const std::wstring& s)
 {
-    if (s.empty())
-        throw cipher_error("Empty cipher text");
-    
-    std::wstring upper = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
-    for (auto c : s) {
-        if (upper.find(c) == std::wstring::npos)
-            throw cipher_error("Invalid cipher text");
+    if (s.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty cipher text");
+    }
+    size_t bad;
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::validate);
+        bad = Normalize::findNonUpper(s.data(), s.size());
+    }
+    if (bad != s.size()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::invalid_text);
+        throwCipherError("Invalid cipher text");
+    }
+    CIPHER_STATS_INPUT(stats(), s.size(), s.size());
+    return s;
+}
+
+/**
+ * @brief Валидация открытого текста с размещением в заданном источнике памяти
+ * @param [in] s Текст для проверки
+ * @param [in] mr Источник памяти для результата
+ * @return Валидный текст только с русскими буквами в верхнем регистре
+ * @throw cipher_error Если текст не содержит валидных русских букв
+ */
+std::pmr::wstring Table::getValidOpenText(std::wstring_view s, std::pmr::memory_resource* mr)
+{
+    std::pmr::wstring tmp(s.size(), L'\0', mr);
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::validate);
+        tmp.resize(Normalize::letters(s.data(), s.size(), &tmp[0]));
+    }
+    CIPHER_STATS_INPUT(stats(), s.size(), tmp.size());
+    if (tmp.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty text: no valid Russian letters");
+    }
+    return tmp;
+}
+
+/**
+ * @brief Валидация зашифрованного текста, заданного представлением
+ * @param [in] s Зашифрованный текст для проверки
+ * @return Исходное представление, если текст валиден
+ * @throw cipher_error Если текст пустой или содержит не-прописные русские буквы
+ */
+std::wstring_view Table::getValidCipherText(std::wstring_view s)
+{
+    if (s.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty cipher text");
     }
+    size_t bad;
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::validate);
+        bad = Normalize::findNonUpper(s.data(), s.size());
+    }
+    if (bad != s.size()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::invalid_text);
+        throwCipherError("Invalid cipher text");
+    }
+    CIPHER_STATS_INPUT(stats(), s.size(), s.size());
     return s;
 }
 
+/**
+ * @brief Счетчики маршрутной перестановки
+ * @return Общие для всех объектов счетчики
+ */
+CipherStats& Table::stats() noexcept
+{
+    static CipherStats counters;
+    return counters;
+}
+
 /**
  * @brief Конструктор класса Table
  * @param [in] key Ключ шифрования (количество столбцов)
+ * @param [in] maxKey Наибольшее допустимое количество столбцов
+ * @throw cipher_error Если ключ невалиден или больше maxKey
+ */
+Table::Table(int key, int maxKey) : maxCols(maxKey)
+{
+    cols = getValidKey(key);
+}
+
+/**
+ * @brief Смена количества столбцов без создания нового объекта
+ * @param [in] key Новый ключ шифрования (количество столбцов)
  * @throw cipher_error Если ключ невалиден
  */
-Table::Table(int key)
+void Table::setCols(int key)
 {
     cols = getValidKey(key);
 }
@@ -93,34 +173,15 @@ Table::Table(int key)
  * @return Зашифрованный текст
  * @throw cipher_error Если текст невалиден
  */
-std::wstring Table::encrypt(const std::wstring& plain)
+std::wstring Table::encrypt(const std::wstring& plain) const
 {
     std::wstring validText = getValidOpenText(plain);
-    int n = static_cast<int>(validText.length());
-    
-    if (n == 0) return L"";
-    
-    int rows = (n + cols - 1) / cols;
-    
-    vector<vector<wchar_t>> table(rows, vector<wchar_t>(cols, L' '));
-    int index = 0;
-    for (int row = 0; row < rows; row++) {
-        for (int col = 0; col < cols; col++) {
-            if (index < n) {
-                table[row][col] = validText[index++];
-            }
-        }
-    }
-    
-    std::wstring result;
-    for (int col = cols - 1; col >= 0; col--) {
-        for (int row = 0; row < rows; row++) {
-            if (table[row][col] != L' ') {
-                result += table[row][col];
-            }
-        }
+    std::wstring result(validText.size(), L'\0');
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        readColumns(validText.data(), validText.size(), cols, &result[0]);
     }
-    
+    CIPHER_STATS_OUTPUT(stats(), result.size());
     return result;
 }
 
@@ -130,42 +191,506 @@ std::wstring Table::encrypt(const std::wstring& plain)
  * @return Расшифрованный текст
  * @throw cipher_error Если текст невалиден
  */
-std::wstring Table::decrypt(const std::wstring& cipher)
+std::wstring Table::decrypt(const std::wstring& cipher) const
+{
+    const std::wstring& validText = getValidCipherText(cipher);
+    std::wstring result(validText.size(), L'\0');
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        writeColumns(validText.data(), validText.size(), cols, &result[0]);
+    }
+    CIPHER_STATS_OUTPUT(stats(), result.size());
+    return result;
+}
+
+/**
+ * @brief Шифрование открытого текста с памятью из заданного источника
+ * @param [in] plain Открытый текст для шифрования
+ * @param [in] mr Источник памяти
+ * @return Зашифрованный текст
+ * @throw cipher_error Если текст невалиден
+ */
+std::pmr::wstring Table::encrypt(std::wstring_view plain, std::pmr::memory_resource* mr) const
+{
+    std::pmr::wstring validText = getValidOpenText(plain, mr);
+    std::pmr::wstring result(validText.size(), L'\0', mr);
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        readColumns(validText.data(), validText.size(), cols, &result[0], mr);
+    }
+    CIPHER_STATS_OUTPUT(stats(), result.size());
+    return result;
+}
+
+/**
+ * @brief Дешифрование зашифрованного текста с памятью из заданного источника
+ * @param [in] cipher Зашифрованный текст для дешифрования
+ * @param [in] mr Источник памяти
+ * @return Расшифрованный текст
+ * @throw cipher_error Если текст невалиден
+ */
+std::pmr::wstring Table::decrypt(std::wstring_view cipher, std::pmr::memory_resource* mr) const
+{
+    std::wstring_view validText = getValidCipherText(cipher);
+    std::pmr::wstring result(validText.size(), L'\0', mr);
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        writeColumns(validText.data(), validText.size(), cols, &result[0], mr);
+    }
+    CIPHER_STATS_OUTPUT(stats(), result.size());
+    return result;
+}
+
+/**
+ * @brief Шифрование текста из номеров букв
+ * @param [in] plain Открытый текст
+ * @return Зашифрованный текст
+ * @throw cipher_error Если текст пустой
+ */
+IndexedText Table::encrypt(const IndexedText& plain) const
+{
+    if (plain.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty text: no valid Russian letters");
+    }
+    IndexedText result(plain.size());
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        readColumns(plain.data(), plain.size(), cols, result.idx.data());
+    }
+    CIPHER_STATS_INPUT(stats(), plain.size(), plain.size());
+    CIPHER_STATS_OUTPUT(stats(), result.size());
+    return result;
+}
+
+/**
+ * @brief Дешифрование текста из номеров букв
+ * @param [in] cipher Зашифрованный текст
+ * @return Расшифрованный текст
+ * @throw cipher_error Если текст пустой
+ */
+IndexedText Table::decrypt(const IndexedText& cipher) const
+{
+    if (cipher.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty cipher text");
+    }
+    IndexedText result(cipher.size());
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        writeColumns(cipher.data(), cipher.size(), cols, result.idx.data());
+    }
+    CIPHER_STATS_INPUT(stats(), cipher.size(), cipher.size());
+    CIPHER_STATS_OUTPUT(stats(), result.size());
+    return result;
+}
+
+/**
+ * @brief Шифрование открытого текста без исключений
+ * @param [in] plain Открытый текст для шифрования
+ * @param [out] out Зашифрованный текст (пустой при ошибке)
+ * @return cipher_status::empty_text, если текст не содержит русских букв
+ */
+cipher_result Table::tryEncrypt(std::wstring_view plain, std::wstring& out) const
+{
+    std::wstring validText(plain.size(), L'\0');
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::validate);
+        validText.resize(Normalize::letters(plain.data(), plain.size(), &validText[0]));
+    }
+    CIPHER_STATS_INPUT(stats(), plain.size(), validText.size());
+    out.resize(validText.size());
+    if (validText.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        return {cipher_status::empty_text, 0};
+    }
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        readColumns(validText.data(), validText.size(), cols, &out[0]);
+    }
+    CIPHER_STATS_OUTPUT(stats(), out.size());
+    return {};
+}
+
+/**
+ * @brief Дешифрование зашифрованного текста без исключений
+ * @param [in] cipher Зашифрованный текст для дешифрования
+ * @param [out] out Расшифрованный текст (пустой при ошибке)
+ * @return cipher_status::empty_text для пустого текста или
+ * cipher_status::invalid_text и позиция первого не-прописного символа
+ */
+cipher_result Table::tryDecrypt(std::wstring_view cipher, std::wstring& out) const
+{
+    out.clear();
+    if (cipher.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        return {cipher_status::empty_text, 0};
+    }
+    size_t pos;
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::validate);
+        pos = Normalize::findNonUpper(cipher.data(), cipher.size());
+    }
+    if (pos != cipher.size()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::invalid_text);
+        return {cipher_status::invalid_text, pos};
+    }
+    CIPHER_STATS_INPUT(stats(), cipher.size(), cipher.size());
+    out.resize(cipher.size());
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        writeColumns(cipher.data(), cipher.size(), cols, &out[0]);
+    }
+    CIPHER_STATS_OUTPUT(stats(), out.size());
+    return {};
+}
+
+/**
+ * @brief Шифрование открытого текста в UTF-8
+ * @param [in] plain Открытый текст в UTF-8
+ * @return Зашифрованный текст в UTF-8
+ * @throw cipher_error Если текст невалиден
+ */
+std::string Table::encrypt(std::string_view plain) const
 {
-    std::wstring validText = getValidCipherText(cipher);
-    int n = static_cast<int>(validText.length());
+    // Разбор UTF-8 в номера букв: ASCII и прочие символы пропускаются
+    vector<uint8_t> work;
+    work.reserve(plain.size() / 2);
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::convert);
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(plain.data());
+        const unsigned char* end = p + plain.size();
+        while (p < end) {
+            int i = Alphabet::utf8Next(p, end);
+            if (i >= 0)
+                work.push_back(static_cast<uint8_t>(i));
+        }
+    }
+    CIPHER_STATS_INPUT(stats(), plain.size(), work.size());
+    if (work.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty text: no valid Russian letters");
+    }
     
-    if (n == 0) return L"";
+    size_t n = work.size();
+    vector<uint8_t> cipherIdx(n);
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        readColumns(work.data(), n, cols, cipherIdx.data());
+    }
     
-    int rows = (n + cols - 1) / cols;
+    std::string result(2 * n, '\0');
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::emit);
+        for (size_t i = 0; i < n; i++)
+            Alphabet::utf8Letter(cipherIdx[i], &result[2 * i]);
+    }
+    CIPHER_STATS_OUTPUT(stats(), result.size());
+    return result;
+}
+
+/**
+ * @brief Дешифрование зашифрованного текста в UTF-8
+ * @param [in] cipher Зашифрованный текст в UTF-8
+ * @return Расшифрованный текст в UTF-8
+ * @throw cipher_error Если текст невалиден
+ */
+std::string Table::decrypt(std::string_view cipher) const
+{
+    if (cipher.empty()) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::empty_text);
+        throwCipherError("Empty cipher text");
+    }
+    if (cipher.size() % 2 != 0) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::invalid_text);
+        throwCipherError("Invalid cipher text");
+    }
     
-    int fullCols = n % cols;
-    if (fullCols == 0) fullCols = cols;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(cipher.data());
+    size_t n = cipher.size() / 2;
+    vector<uint8_t> work(n);
+    int bad = 0;
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::convert);
+        for (size_t i = 0; i < n; i++) {
+            int idx = Alphabet::utf8UpperIndex(p[2 * i], p[2 * i + 1]);
+            bad |= Alphabet::utf8Length(p[2 * i]) != 2 ? -1 : idx;
+            work[i] = static_cast<uint8_t>(idx);
+        }
+    }
+    if (bad < 0) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::invalid_text);
+        throwCipherError("Invalid cipher text");
+    }
+    CIPHER_STATS_INPUT(stats(), cipher.size(), n);
     
-    vector<vector<wchar_t>> table(rows, vector<wchar_t>(cols, L' '));
-    int index = 0;
+    vector<uint8_t> plainIdx(n);
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        writeColumns(work.data(), n, cols, plainIdx.data());
+    }
     
-    for (int col = cols - 1; col >= 0; col--) {
-        int rowsInCol = rows;
-        if (col >= fullCols) {
-            rowsInCol = rows - 1;
-        }
-        
-        for (int row = 0; row < rowsInCol; row++) {
-            if (index < n) {
-                table[row][col] = validText[index++];
-            }
+    std::string result(cipher.size(), '\0');
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::emit);
+        for (size_t i = 0; i < n; i++)
+            Alphabet::utf8Letter(plainIdx[i], &result[2 * i]);
+    }
+    CIPHER_STATS_OUTPUT(stats(), result.size());
+    return result;
+}
+
+/**
+ * @brief План перестановки для текста заданной длины
+ * @param [in] n Длина текста в буквах
+ * @return План перестановки
+ */
+std::shared_ptr<const TablePlan> Table::plan(size_t n) const
+{
+    return planCache.get(cols, n);
+}
+
+/**
+ * @brief Шифрование набора сообщений
+ * @param [in] plains Открытые тексты
+ * @return Зашифрованные тексты
+ * @throw cipher_error Если текст невалиден
+ */
+std::vector<std::wstring> Table::encryptBatch(const std::vector<std::wstring>& plains) const
+{
+    std::vector<std::wstring> results;
+    results.reserve(plains.size());
+    std::shared_ptr<const TablePlan> current;
+    for (const auto& plain : plains) {
+        std::wstring validText = getValidOpenText(plain);
+        if (!current || current->length() != validText.size())
+            current = plan(validText.size());
+        std::wstring result(validText.size(), L'\0');
+        current->encrypt(validText.data(), &result[0]);
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+/**
+ * @brief Дешифрование набора сообщений
+ * @param [in] ciphers Зашифрованные тексты
+ * @return Расшифрованные тексты
+ * @throw cipher_error Если текст невалиден
+ */
+std::vector<std::wstring> Table::decryptBatch(const std::vector<std::wstring>& ciphers) const
+{
+    std::vector<std::wstring> results;
+    results.reserve(ciphers.size());
+    std::shared_ptr<const TablePlan> current;
+    for (const auto& cipher : ciphers) {
+        const std::wstring& validText = getValidCipherText(cipher);
+        if (!current || current->length() != validText.size())
+            current = plan(validText.size());
+        std::wstring result(validText.size(), L'\0');
+        current->decrypt(validText.data(), &result[0]);
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+/**
+ * @brief Пакетное шифрование сообщений в общий буфер
+ * @param [in] plains Открытые тексты
+ * @param [in] count Количество сообщений
+ * @param [out] out Результаты пакета
+ */
+void Table::encryptBatch(const std::wstring_view* plains, size_t count, CipherBatch& out) const
+{
+    wchar_t* arena = out.prepare(plains, count);
+    std::wstring letters;
+    for (size_t i = 0; i < count; i++) {
+        letters.resize(plains[i].size());
+        letters.resize(Normalize::letters(plains[i].data(), plains[i].size(), &letters[0]));
+        if (letters.empty()) {
+            out.push(cipher_status::empty_text, 0);
+            continue;
         }
+        readColumns(letters.data(), letters.size(), cols, arena + out.offsets.back());
+        out.push(cipher_status::ok, letters.size());
     }
-    
-    std::wstring result;
-    for (int row = 0; row < rows; row++) {
-        for (int col = 0; col < cols; col++) {
-            if (table[row][col] != L' ') {
-                result += table[row][col];
-            }
+    out.finish();
+}
+
+/**
+ * @brief Пакетное дешифрование сообщений в общий буфер
+ * @param [in] ciphers Зашифрованные тексты
+ * @param [in] count Количество сообщений
+ * @param [out] out Результаты пакета
+ */
+void Table::decryptBatch(const std::wstring_view* ciphers, size_t count, CipherBatch& out) const
+{
+    wchar_t* arena = out.prepare(ciphers, count);
+    for (size_t i = 0; i < count; i++) {
+        const std::wstring_view& cipher = ciphers[i];
+        if (cipher.empty()) {
+            out.push(cipher_status::empty_text, 0);
+        } else if (Normalize::findNonUpper(cipher.data(), cipher.size()) != cipher.size()) {
+            out.push(cipher_status::invalid_text, 0);
+        } else {
+            writeColumns(cipher.data(), cipher.size(), cols, arena + out.offsets.back());
+            out.push(cipher_status::ok, cipher.size());
         }
     }
-    
+    out.finish();
+}
+
+/**
+ * @brief Параллельное шифрование открытого текста
+ * @param [in] plain Открытый текст для шифрования
+ * @param [in] threads Количество потоков (0 - по числу ядер)
+ * @return Зашифрованный текст
+ * @throw cipher_error Если текст невалиден
+ */
+std::wstring Table::encryptParallel(const std::wstring& plain, unsigned threads) const
+{
+    std::wstring validText = getValidOpenText(plain);
+    std::wstring result(validText.size(), L'\0');
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        readColumnsParallel(validText.data(), validText.size(), cols, &result[0], parallelThreads(threads));
+    }
+    CIPHER_STATS_OUTPUT(stats(), result.size());
+    return result;
+}
+
+/**
+ * @brief Параллельное дешифрование зашифрованного текста
+ * @param [in] cipher Зашифрованный текст для дешифрования
+ * @param [in] threads Количество потоков (0 - по числу ядер)
+ * @return Расшифрованный текст
+ * @throw cipher_error Если текст невалиден
+ */
+std::wstring Table::decryptParallel(const std::wstring& cipher, unsigned threads) const
+{
+    const std::wstring& validText = getValidCipherText(cipher);
+    std::wstring result(validText.size(), L'\0');
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        writeColumnsParallel(validText.data(), validText.size(), cols, &result[0], parallelThreads(threads));
+    }
+    CIPHER_STATS_OUTPUT(stats(), result.size());
+    return result;
+}
+
+/**
+ * @brief Дешифрование участка зашифрованного текста
+ * @param [in] cipher Весь зашифрованный текст
+ * @param [in] pos Позиция первой буквы участка
+ * @param [in] len Количество букв участка
+ * @return Расшифрованный участок
+ * @throw cipher_error Если участок выходит за текст или невалиден
+ */
+std::wstring Table::decryptRange(std::wstring_view cipher, size_t pos, size_t len) const
+{
+    size_t n = cipher.size();
+    if (pos > n || len > n - pos)
+        throwCipherError("Range out of bounds");
+    std::wstring result(len, L'\0');
+    int bad = 0;
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        columnRange(n, cols, pos, len, [&](size_t k, size_t i) {
+            bad |= Alphabet::upperIndex(cipher[i]);
+            result[k] = cipher[i];
+        });
+    }
+    if (bad < 0) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::invalid_text);
+        throwCipherError("Invalid cipher text");
+    }
+    CIPHER_STATS_INPUT(stats(), len, len);
+    CIPHER_STATS_OUTPUT(stats(), len);
+    return result;
+}
+
+/**
+ * @brief Дешифрование участка зашифрованного текста в UTF-8
+ * @param [in] cipher Весь зашифрованный текст в UTF-8
+ * @param [in] pos Позиция первой буквы участка
+ * @param [in] len Количество букв участка
+ * @return Расшифрованный участок в UTF-8
+ * @throw cipher_error Если участок выходит за текст или невалиден
+ */
+std::string Table::decryptRange(std::string_view cipher, size_t pos, size_t len) const
+{
+    if (cipher.size() % 2 != 0) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::invalid_text);
+        throwCipherError("Invalid cipher text");
+    }
+    size_t n = cipher.size() / 2;
+    if (pos > n || len > n - pos)
+        throwCipherError("Range out of bounds");
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(cipher.data());
+    std::string result(2 * len, '\0');
+    int bad = 0;
+    {
+        CIPHER_STATS_TIMER(stats(), cipher_stage::transform);
+        columnRange(n, cols, pos, len, [&](size_t k, size_t i) {
+            int idx = Alphabet::utf8UpperIndex(p[2 * i], p[2 * i + 1]);
+            bad |= Alphabet::utf8Length(p[2 * i]) != 2 ? -1 : idx;
+            result[2 * k] = cipher[2 * i];
+            result[2 * k + 1] = cipher[2 * i + 1];
+        });
+    }
+    if (bad < 0) {
+        CIPHER_STATS_REJECT(stats(), cipher_status::invalid_text);
+        throwCipherError("Invalid cipher text");
+    }
+    CIPHER_STATS_INPUT(stats(), 2 * len, len);
+    CIPHER_STATS_OUTPUT(stats(), result.size());
+    return result;
+}
+
+/**
+ * @brief Конструктор по последовательности ключей
+ * @param [in] rounds Количество столбцов в каждом раунде
+ * @param [in] maxKey Наибольшее допустимое количество столбцов
+ * @throw cipher_error Если список пуст или ключ невалиден
+ */
+MultiTable::MultiTable(const std::vector<int>& rounds, int maxKey)
+{
+    if (rounds.empty())
+        throwCipherError("Invalid key: no rounds");
+    for (int key : rounds)
+        keys.push_back(Table(key, maxKey).cols);
+}
+
+/**
+ * @brief Шифрование открытого текста всеми раундами
+ * @param [in] plain Открытый текст для шифрования
+ * @return Зашифрованный текст
+ * @throw cipher_error Если текст невалиден
+ */
+std::wstring MultiTable::encrypt(const std::wstring& plain) const
+{
+    std::wstring validText = Table::getValidOpenText(plain);
+    std::wstring result(validText.size(), L'\0');
+    if (auto plan = planCache.getRepeated(keys, validText.size()))
+        plan->encrypt(validText.data(), &result[0]);
+    else
+        readRounds(validText.data(), validText.size(), keys, &result[0]);
+    return result;
+}
+
+/**
+ * @brief Дешифрование зашифрованного текста всеми раундами
+ * @param [in] cipher Зашифрованный текст для дешифрования
+ * @return Расшифрованный текст
+ * @throw cipher_error Если текст невалиден
+ */
+std::wstring MultiTable::decrypt(const std::wstring& cipher) const
+{
+    const std::wstring& validText = Table::getValidCipherText(cipher);
+    std::wstring result(validText.size(), L'\0');
+    if (auto plan = planCache.getRepeated(keys, validText.size()))
+        plan->decrypt(validText.data(), &result[0]);
+    else
+        writeRounds(validText.data(), validText.size(), keys, &result[0]);
     return result;
 }
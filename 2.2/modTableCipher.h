@@ -8,44 +8,52 @@
  */
 
 #pragma once
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <stdexcept>
-
-/**
- * @brief Класс исключений для ошибок шифрования
- * @details Наследуется от std::invalid_argument
- */
-class cipher_error: public std::invalid_argument {
-public:
-    /**
-     * @brief Конструктор с строковым параметром
-     * @param [in] what_arg Сообщение об ошибке
-     */
-    explicit cipher_error (const std::string& what_arg):
-        std::invalid_argument(what_arg) {}
-    /**
-     * @brief Конструктор с C-строкой
-     * @param [in] what_arg Сообщение об ошибке
-     */
-    explicit cipher_error (const char* what_arg):
-        std::invalid_argument(what_arg) {}
-};
+#include "../common/modAlphabet.h"
+#include "../common/modCipherBatch.h"
+#include "../common/modCipherError.h"
+#include "../common/modCipherStatus.h"
+#include "../common/modIndexedText.h"
+#include "../common/modNormalize.h"
+#include "../common/modStats.h"
+#include "modTablePlan.h"
 
 /**
  * @brief Класс для шифрования методом табличной маршрутной перестановки
- * @details Реализует шифрование и дешифрование текста на русском языке
+ * @details Реализует шифрование и дешифрование текста на русском языке.
+ * Все методы шифрования и дешифрования константны и не изменяют объект,
+ * поэтому один объект можно использовать из нескольких потоков
+ * одновременно. Одиночные сообщения переставляются без кэша планов.
+ * encryptBatch() и decryptBatch() для std::vector и plan() ищут план без
+ * блокировок; при промахе план строится вне мьютекса кэша, а мьютекс
+ * берется только для публикации. setCols() нельзя вызывать параллельно
+ * с шифрованием
  */
 class Table
 {
+    friend class MultiTable;
+    friend class modProductCipher;
+    template <int> friend class TableFixed;
+    friend class TableFramed;
+    friend struct TableBench;
+public:
+    static constexpr size_t planCacheSize = 8; /**< Наибольшее число планов перестановки в кэше */
+    static constexpr size_t planCacheBytes = size_t(4) << 20; /**< Наибольший суммарный размер планов в кэше, байт */
+    static constexpr int defaultMaxKey = 100;  /**< Наибольшее количество столбцов по умолчанию */
+    
 private:
     int cols; /**< Количество столбцов таблицы */
+    int maxCols; /**< Наибольшее допустимое количество столбцов */
+    mutable TablePlanCache planCache{planCacheSize, planCacheBytes}; /**< Кэш планов перестановки по длине текста */
     
     /**
      * @brief Валидация ключа шифрования
      * @param [in] key Ключ для проверки
      * @return Валидный ключ
-     * @throw cipher_error Если ключ невалиден
+     * @throw cipher_error Если ключ невалиден или больше maxCols
      */
     int getValidKey(const int key);
     
@@ -55,23 +63,88 @@ private:
      * @return Валидный текст только с русскими буквами в верхнем регистре
      * @throw cipher_error Если текст не содержит валидных русских букв
      */
-    std::wstring getValidOpenText(const std::wstring& s);
+    static std::wstring getValidOpenText(const std::wstring& s);
+    
+    /**
+     * @brief Валидация открытого текста с размещением в заданном источнике памяти
+     * @param [in] s Текст для проверки
+     * @param [in] mr Источник памяти для результата
+     * @return Валидный текст только с русскими буквами в верхнем регистре
+     * @throw cipher_error Если текст не содержит валидных русских букв
+     */
+    static std::pmr::wstring getValidOpenText(std::wstring_view s, std::pmr::memory_resource* mr);
     
     /**
      * @brief Валидация зашифрованного текста
      * @param [in] s Зашифрованный текст для проверки
-     * @return Валидный зашифрованный текст
+     * @return Ссылка на исходный текст, если он валиден
+     * @throw cipher_error Если текст пустой или содержит не-прописные русские буквы
+     */
+    static const std::wstring& getValidCipherText(const std::wstring& s);
+    
+    /**
+     * @brief Валидация зашифрованного текста, заданного представлением
+     * @param [in] s Зашифрованный текст для проверки
+     * @return Исходное представление, если текст валиден
      * @throw cipher_error Если текст пустой или содержит не-прописные русские буквы
      */
-    std::wstring getValidCipherText(const std::wstring& s);
+    static std::wstring_view getValidCipherText(std::wstring_view s);
     
 public:
     /**
      * @brief Конструктор класса Table
+     * @details Количество столбцов может превышать длину текста: при
+     * cols >= n текст записывается в одну строку и читается справа налево.
+     * Перестановка использует память, пропорциональную длине текста, при
+     * любом количестве столбцов
      * @param [in] key Ключ шифрования (количество столбцов)
-     * @throw cipher_error Если ключ невалиден
+     * @param [in] maxKey Наибольшее допустимое количество столбцов
+     * @throw cipher_error Если ключ невалиден или больше maxKey
      */
-    explicit Table(int key);
+    explicit Table(int key, int maxKey = defaultMaxKey);
+    
+    /**
+     * @brief Счетчики маршрутной перестановки
+     * @details Общие для всех объектов Table; обновляются только при сборке
+     * с CIPHER_STATS. Снимок stats().snapshot() не блокирует шифрование
+     * @return Счетчики
+     */
+    static CipherStats& stats() noexcept;
+    
+    /**
+     * @brief Смена количества столбцов без создания нового объекта
+     * @details Кэш планов сохраняется: планы различаются по количеству
+     * столбцов и длине текста
+     * @param [in] key Новый ключ шифрования (количество столбцов)
+     * @throw cipher_error Если ключ невалиден или больше заданного в
+     * конструкторе предела; прежний ключ сохраняется
+     */
+    void setCols(int key);
+    
+    /**
+     * @brief Проверка ключа без исключений
+     * @param [in] key Количество столбцов
+     * @param [in] maxKey Наибольшее допустимое количество столбцов
+     * @return cipher_status::invalid_key или успешный результат
+     */
+    static cipher_result checkKey(int key, int maxKey = defaultMaxKey) noexcept;
+    
+    /**
+     * @brief Шифрование открытого текста без исключений
+     * @param [in] plain Открытый текст для шифрования
+     * @param [out] out Зашифрованный текст (пустой при ошибке)
+     * @return cipher_status::empty_text, если текст не содержит русских букв
+     */
+    cipher_result tryEncrypt(std::wstring_view plain, std::wstring& out) const;
+    
+    /**
+     * @brief Дешифрование зашифрованного текста без исключений
+     * @param [in] cipher Зашифрованный текст для дешифрования
+     * @param [out] out Расшифрованный текст (пустой при ошибке)
+     * @return cipher_status::empty_text для пустого текста или
+     * cipher_status::invalid_text и позиция первого не-прописного символа
+     */
+    cipher_result tryDecrypt(std::wstring_view cipher, std::wstring& out) const;
     
     /**
      * @brief Шифрование открытого текста
@@ -79,7 +152,7 @@ public:
      * @return Зашифрованный текст
      * @throw cipher_error Если текст невалиден
      */
-    std::wstring encrypt(const std::wstring& plain);
+    std::wstring encrypt(const std::wstring& plain) const;
     
     /**
      * @brief Дешифрование зашифрованного текста
@@ -87,5 +160,201 @@ public:
      * @return Расшифрованный текст
      * @throw cipher_error Если текст невалиден
      */
-    std::wstring decrypt(const std::wstring& cipher);
+    std::wstring decrypt(const std::wstring& cipher) const;
+    
+    /**
+     * @brief Шифрование открытого текста с памятью из заданного источника
+     * @details Из источника выделяются отфильтрованный текст, результат и
+     * разметка блочного обхода. Планы перестановки в кэше живут дольше
+     * одного запроса и по-прежнему размещаются в общей куче
+     * @param [in] plain Открытый текст для шифрования
+     * @param [in] mr Источник памяти
+     * @return Зашифрованный текст
+     * @throw cipher_error Если текст невалиден
+     */
+    std::pmr::wstring encrypt(std::wstring_view plain, std::pmr::memory_resource* mr) const;
+    
+    /**
+     * @brief Дешифрование зашифрованного текста с памятью из заданного источника
+     * @param [in] cipher Зашифрованный текст для дешифрования
+     * @param [in] mr Источник памяти
+     * @return Расшифрованный текст
+     * @throw cipher_error Если текст невалиден
+     */
+    std::pmr::wstring decrypt(std::wstring_view cipher, std::pmr::memory_resource* mr) const;
+    
+    /**
+     * @brief Шифрование текста из номеров букв
+     * @details Текст проверен и нормализован при построении IndexedText,
+     * поэтому выполняется только перестановка однобайтовых номеров
+     * @param [in] plain Открытый текст
+     * @return Зашифрованный текст
+     * @throw cipher_error Если текст пустой
+     */
+    IndexedText encrypt(const IndexedText& plain) const;
+    
+    /**
+     * @brief Дешифрование текста из номеров букв
+     * @param [in] cipher Зашифрованный текст
+     * @return Расшифрованный текст
+     * @throw cipher_error Если текст пустой
+     */
+    IndexedText decrypt(const IndexedText& cipher) const;
+    
+    /**
+     * @brief Шифрование открытого текста в UTF-8
+     * @details Двухбайтовые последовательности русских букв разбираются
+     * напрямую, перестановка выполняется над однобайтовыми номерами букв
+     * @param [in] plain Открытый текст в UTF-8
+     * @return Зашифрованный текст в UTF-8
+     * @throw cipher_error Если текст не содержит русских букв
+     */
+    std::string encrypt(std::string_view plain) const;
+    
+    /**
+     * @brief Дешифрование зашифрованного текста в UTF-8
+     * @param [in] cipher Зашифрованный текст в UTF-8
+     * @return Расшифрованный текст в UTF-8
+     * @throw cipher_error Если текст пустой или содержит не-прописные русские буквы
+     */
+    std::string decrypt(std::string_view cipher) const;
+    
+    /**
+     * @brief План перестановки для текста заданной длины
+     * @details План берется из ограниченного кэша или строится и
+     * помещается в него; план больше planCacheBytes строится заново
+     * при каждом вызове
+     * @param [in] n Длина текста в буквах
+     * @return План перестановки для текущего количества столбцов
+     */
+    std::shared_ptr<const TablePlan> plan(size_t n) const;
+    
+    /**
+     * @brief Шифрование набора сообщений
+     * @details Сообщения одинаковой длины используют один план
+     * перестановки, поэтому каждое обходится одним проходом сбора
+     * @param [in] plains Открытые тексты
+     * @return Зашифрованные тексты в том же порядке
+     * @throw cipher_error Если хотя бы один текст невалиден
+     */
+    std::vector<std::wstring> encryptBatch(const std::vector<std::wstring>& plains) const;
+    
+    /**
+     * @brief Дешифрование набора сообщений
+     * @param [in] ciphers Зашифрованные тексты
+     * @return Расшифрованные тексты в том же порядке
+     * @throw cipher_error Если хотя бы один текст невалиден
+     */
+    std::vector<std::wstring> decryptBatch(const std::vector<std::wstring>& ciphers) const;
+    
+    /**
+     * @brief Параллельное шифрование открытого текста
+     * @details Полные строки таблицы делятся на полосы по числу потоков;
+     * каждая полоса записывает свой участок каждого столбца шифротекста.
+     * Тексты короче transposeThreshold шифруются в вызывающем потоке
+     * @param [in] plain Открытый текст для шифрования
+     * @param [in] threads Количество потоков (0 - по числу ядер)
+     * @return Зашифрованный текст, совпадающий с результатом encrypt()
+     * @throw cipher_error Если текст невалиден
+     */
+    std::wstring encryptParallel(const std::wstring& plain, unsigned threads = 0) const;
+    
+    /**
+     * @brief Параллельное дешифрование зашифрованного текста
+     * @param [in] cipher Зашифрованный текст для дешифрования
+     * @param [in] threads Количество потоков (0 - по числу ядер)
+     * @return Расшифрованный текст, совпадающий с результатом decrypt()
+     * @throw cipher_error Если текст невалиден
+     */
+    std::wstring decryptParallel(const std::wstring& cipher, unsigned threads = 0) const;
+    
+    /**
+     * @brief Дешифрование участка зашифрованного текста
+     * @details Позиция каждой буквы участка в шифротексте вычисляется по
+     * формуле из длины текста и количества столбцов, поэтому читаются и
+     * проверяются только len букв. Для отображенного в память шифротекста
+     * запрос стоит O(len)
+     * @param [in] cipher Весь зашифрованный текст
+     * @param [in] pos Позиция первой буквы участка в открытом тексте
+     * @param [in] len Количество букв участка
+     * @return Расшифрованный участок, совпадающий с decrypt().substr(pos, len)
+     * @throw cipher_error Если участок выходит за текст или прочитанные
+     * буквы не прописные
+     */
+    std::wstring decryptRange(std::wstring_view cipher, size_t pos, size_t len) const;
+    
+    /**
+     * @brief Дешифрование участка зашифрованного текста в UTF-8
+     * @details Каждая буква шифротекста занимает два байта
+     * @param [in] cipher Весь зашифрованный текст в UTF-8
+     * @param [in] pos Позиция первой буквы участка в открытом тексте
+     * @param [in] len Количество букв участка
+     * @return Расшифрованный участок в UTF-8
+     * @throw cipher_error Если участок выходит за текст или текст невалиден
+     */
+    std::string decryptRange(std::string_view cipher, size_t pos, size_t len) const;
+    
+    /**
+     * @brief Пакетное шифрование сообщений в общий буфер
+     * @details Буквы каждого сообщения отбираются во временный буфер,
+     * общий для всего пакета, и переставляются прямо в out.arena.
+     * Сообщение без русских букв отмечается cipher_status::empty_text и
+     * не прерывает обработку остальных
+     * @param [in] plains Открытые тексты
+     * @param [in] count Количество сообщений
+     * @param [out] out Результаты пакета
+     */
+    void encryptBatch(const std::wstring_view* plains, size_t count, CipherBatch& out) const;
+    
+    /**
+     * @brief Пакетное дешифрование сообщений в общий буфер
+     * @details Пустое сообщение отмечается cipher_status::empty_text,
+     * сообщение с не-прописными буквами - cipher_status::invalid_text
+     * @param [in] ciphers Зашифрованные тексты
+     * @param [in] count Количество сообщений
+     * @param [out] out Результаты пакета
+     */
+    void decryptBatch(const std::wstring_view* ciphers, size_t count, CipherBatch& out) const;
+};
+
+/**
+ * @brief Класс многораундовой табличной маршрутной перестановки
+ * @details Последовательно применяет перестановки Table с разными
+ * количествами столбцов. Текст проверяется один раз, затем раунды
+ * переставляются подряд блочным проходом по столбцам без повторной
+ * проверки и без построения плана. Для повторяющихся длин составной
+ * план берется из кэша и применяется одним проходом сбора. Методы
+ * константны и безопасны при одновременном вызове
+ */
+class MultiTable
+{
+private:
+    std::vector<int> keys; /**< Количество столбцов в каждом раунде */
+    mutable TablePlanCache planCache{Table::planCacheSize, Table::planCacheBytes}; /**< Кэш составных планов повторяющихся длин */
+    
+public:
+    /**
+     * @brief Конструктор по последовательности ключей
+     * @param [in] rounds Количество столбцов в каждом раунде в порядке шифрования
+     * @param [in] maxKey Наибольшее допустимое количество столбцов
+     * @throw cipher_error Если список пуст или хотя бы один ключ невалиден
+     */
+    explicit MultiTable(const std::vector<int>& rounds, int maxKey = Table::defaultMaxKey);
+    
+    /**
+     * @brief Шифрование открытого текста всеми раундами
+     * @param [in] plain Открытый текст для шифрования
+     * @return Зашифрованный текст, совпадающий с последовательным
+     * применением Table::encrypt для каждого ключа
+     * @throw cipher_error Если текст невалиден
+     */
+    std::wstring encrypt(const std::wstring& plain) const;
+    
+    /**
+     * @brief Дешифрование зашифрованного текста всеми раундами
+     * @param [in] cipher Зашифрованный текст для дешифрования
+     * @return Расшифрованный текст
+     * @throw cipher_error Если текст невалиден
+     */
+    std::wstring decrypt(const std::wstring& cipher) const;
 };
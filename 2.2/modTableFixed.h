@@ -0,0 +1,130 @@
+/**
+ * @file modTableFixed.h
+ * @brief Заголовочный файл для шаблона TableFixed
+ * @details Табличная маршрутная перестановка с количеством столбцов,
+ * известным на этапе компиляции
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include "modTableCipher.h"
+#include "modTranspose.h"
+
+/**
+ * @brief Табличная маршрутная перестановка с фиксированным количеством столбцов
+ * @details Количество строк и длины столбцов вычисляются делением на
+ * константу, а проход по строке таблицы имеет постоянную длину Cols и
+ * может быть развернут компилятором. Начиная с transposeThreshold
+ * символов используется блочное ядро, общее с Table. Проверка текста
+ * общая с Table, поэтому результат и исключения совпадают с Table(Cols).
+ * Верхней границы нет, как у Table с заданным maxKey
+ * @tparam Cols Количество столбцов таблицы (не меньше 1)
+ */
+template <int Cols>
+class TableFixed
+{
+    static_assert(Cols > 0, "Invalid key: cannot be zero");
+
+public:
+    static constexpr size_t cols = Cols; /**< Количество столбцов таблицы */
+
+    /**
+     * @brief Чтение таблицы по столбцам справа налево
+     * @details Таблица обходится по строкам, каждый символ строки
+     * записывается в свой столбец шифротекста; длинные тексты читаются
+     * плитками, помещающимися в кэш
+     * @param [in] src Текст, записанный в таблицу по строкам
+     * @param [in] n Длина текста
+     * @param [out] dst Буфер для результата длиной n
+     */
+    template <class T>
+    static void readColumns(const T* src, size_t n, T* dst)
+    {
+        if (n >= transposeThreshold) {
+            ::readColumns(src, n, cols, dst);
+            return;
+        }
+        size_t colStart[Cols];
+        size_t fullRows = layout(n, colStart);
+        for (size_t row = 0; row < fullRows; row++, src += Cols)
+            for (size_t col = 0; col < cols; col++)
+                dst[colStart[col] + row] = src[col];
+        for (size_t col = 0; col < n % cols; col++)
+            dst[colStart[col] + fullRows] = src[col];
+    }
+
+    /**
+     * @brief Запись таблицы по столбцам справа налево
+     * @details Обратное преобразование к readColumns()
+     * @param [in] src Текст, прочитанный из таблицы по столбцам
+     * @param [in] n Длина текста
+     * @param [out] dst Буфер для результата длиной n
+     */
+    template <class T>
+    static void writeColumns(const T* src, size_t n, T* dst)
+    {
+        if (n >= transposeThreshold) {
+            ::writeColumns(src, n, cols, dst);
+            return;
+        }
+        size_t colStart[Cols];
+        size_t fullRows = layout(n, colStart);
+        for (size_t row = 0; row < fullRows; row++, dst += Cols)
+            for (size_t col = 0; col < cols; col++)
+                dst[col] = src[colStart[col] + row];
+        for (size_t col = 0; col < n % cols; col++)
+            dst[col] = src[colStart[col] + fullRows];
+    }
+
+    /**
+     * @brief Шифрование открытого текста
+     * @param [in] plain Открытый текст для шифрования
+     * @return Зашифрованный текст, совпадающий с Table(Cols).encrypt()
+     * @throw cipher_error Если текст невалиден
+     */
+    std::wstring encrypt(const std::wstring& plain) const
+    {
+        std::wstring validText = Table::getValidOpenText(plain);
+        std::wstring result(validText.size(), L'\0');
+        readColumns(validText.data(), validText.size(), &result[0]);
+        return result;
+    }
+
+    /**
+     * @brief Дешифрование зашифрованного текста
+     * @param [in] cipher Зашифрованный текст для дешифрования
+     * @return Расшифрованный текст, совпадающий с Table(Cols).decrypt()
+     * @throw cipher_error Если текст невалиден
+     */
+    std::wstring decrypt(const std::wstring& cipher) const
+    {
+        const std::wstring& validText = Table::getValidCipherText(cipher);
+        std::wstring result(validText.size(), L'\0');
+        writeColumns(validText.data(), validText.size(), &result[0]);
+        return result;
+    }
+
+private:
+    /**
+     * @brief Начала столбцов в шифротексте
+     * @param [in] n Длина текста
+     * @param [out] colStart Смещение каждого столбца в шифротексте
+     * @return Количество полных строк таблицы
+     */
+    static size_t layout(size_t n, size_t* colStart) noexcept
+    {
+        size_t fullRows = n / cols;
+        size_t extra = n % cols;
+        // Столбцы читаются справа налево; первые extra столбцов на одну букву длиннее
+        size_t pos = 0;
+        for (size_t col = cols; col-- > 0; ) {
+            colStart[col] = pos;
+            pos += fullRows + (col < extra ? 1 : 0);
+        }
+        return fullRows;
+    }
+};
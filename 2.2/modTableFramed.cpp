@@ -0,0 +1,351 @@
+/**
+ * @file modTableFramed.cpp
+ * @brief Реализация блочного формата маршрутной перестановки
+ * @details Содержит реализацию классов TableFramed и TableFrameStream
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include "modTableFramed.h"
+#include "modTranspose.h"
+#include "../common/modIndexedText.h"
+#include "../common/modParallel.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace {
+
+/// Сигнатура блочного формата
+constexpr char frameMagic[4] = {'T', 'B', 'F', '1'};
+
+/**
+ * @brief Запись 32-битного числа в little-endian
+ * @param [in] v Число
+ * @param [out] out Буфер длиной 4 байта
+ */
+void putU32(uint32_t v, char* out)
+{
+    for (int i = 0; i < 4; ++i)
+        out[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+}
+
+/**
+ * @brief Чтение 32-битного числа в little-endian
+ * @param [in] in Буфер длиной 4 байта
+ * @return Число
+ */
+uint32_t getU32(const char* in)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i)
+        v |= static_cast<uint32_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    return v;
+}
+
+/**
+ * @brief Длина полной части текста в UTF-8
+ * @param [in] s Текст, возможно оборванный внутри символа
+ * @return Длина без последнего неполного символа
+ */
+size_t completeUtf8(string_view s)
+{
+    size_t lead = s.size();
+    while (lead > 0 && s.size() - lead < 4 && (static_cast<unsigned char>(s[lead - 1]) & 0xC0) == 0x80)
+        --lead;
+    if (lead > 0 && static_cast<size_t>(Alphabet::utf8Length(s[lead - 1])) > s.size() - lead + 1)
+        return lead - 1;
+    return s.size();
+}
+
+} // namespace
+
+/**
+ * @brief Проверка длины блока
+ * @param [in] cols Количество столбцов
+ * @param [in] letters Длина блока
+ * @return Валидная длина блока
+ * @throw cipher_error Если длина не кратна cols или слишком велика
+ */
+size_t TableFramed::getValidBlock(int cols, size_t letters)
+{
+    if (letters == 0 || letters % static_cast<size_t>(cols) != 0 || letters > maxBlockLetters)
+        throwCipherError("Invalid block size");
+    return letters;
+}
+
+/**
+ * @brief Конструктор по числу столбцов и длине блока
+ * @param [in] cols Количество столбцов таблицы
+ * @param [in] letters Длина блока в буквах, кратная cols
+ * @throw cipher_error Если ключ или длина блока невалидны
+ */
+TableFramed::TableFramed(int cols, size_t letters)
+    : table(cols, static_cast<int>(maxBlockLetters)), blockLetters(getValidBlock(cols, letters))
+{
+}
+
+/**
+ * @brief Конструктор по заголовку блочного текста
+ * @param [in] framed Блочный текст, начинающийся с заголовка
+ * @return Формат с параметрами из заголовка
+ * @throw cipher_error Если заголовок невалиден
+ */
+TableFramed TableFramed::fromHeader(string_view framed)
+{
+    if (framed.size() < headerSize || memcmp(framed.data(), frameMagic, sizeof(frameMagic)) != 0)
+        throwCipherError("Invalid framed text");
+    uint32_t cols = getU32(framed.data() + 4);
+    if (!Table::checkKey(static_cast<int>(min<uint32_t>(cols, 1u << 30)), static_cast<int>(maxBlockLetters)))
+        throwCipherError("Invalid framed text");
+    return TableFramed(static_cast<int>(cols), getU32(framed.data() + 8));
+}
+
+/**
+ * @brief Заголовок блочного текста
+ * @return headerSize байт
+ */
+string TableFramed::header() const
+{
+    string h(headerSize, '\0');
+    memcpy(&h[0], frameMagic, sizeof(frameMagic));
+    putU32(static_cast<uint32_t>(table.cols), &h[4]);
+    putU32(static_cast<uint32_t>(blockLetters), &h[8]);
+    return h;
+}
+
+/**
+ * @brief Шифрование одного блока
+ * @param [in] idx Номера букв блока
+ * @param [in] n Количество букв, 1..blockSize()
+ * @param [out] out Буфер для кадра длиной frameHeaderSize + 2 * n
+ * @param [out] work Рабочий буфер длиной не менее n
+ * @return Размер кадра в байтах
+ */
+size_t TableFramed::encryptFrame(const uint8_t* idx, size_t n, char* out, uint8_t* work) const
+{
+    readColumns(idx, n, table.cols, work);
+    putU32(static_cast<uint32_t>(n), out);
+    char* payload = out + frameHeaderSize;
+    for (size_t i = 0; i < n; i++)
+        Alphabet::utf8Letter(work[i], payload + 2 * i);
+    return frameHeaderSize + 2 * n;
+}
+
+/**
+ * @brief Дешифрование полезной нагрузки одного кадра
+ * @param [in] payload Буквы кадра в UTF-8
+ * @param [in] n Количество букв
+ * @param [out] out Буфер для открытого текста длиной 2 * n
+ * @param [out] work Рабочий буфер длиной не менее 2 * n
+ * @throw cipher_error Если кадр содержит не-прописные буквы
+ */
+void TableFramed::decryptFrame(const char* payload, size_t n, char* out, uint8_t* work) const
+{
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(payload);
+    int bad = 0;
+    for (size_t i = 0; i < n; i++) {
+        int idx = Alphabet::utf8UpperIndex(p[2 * i], p[2 * i + 1]);
+        bad |= Alphabet::utf8Length(p[2 * i]) != 2 ? -1 : idx;
+        work[i] = static_cast<uint8_t>(idx);
+    }
+    if (bad < 0)
+        throwCipherError("Invalid cipher text");
+    uint8_t* plain = work + n;
+    writeColumns(work, n, table.cols, plain);
+    for (size_t i = 0; i < n; i++)
+        Alphabet::utf8Letter(plain[i], out + 2 * i);
+}
+
+/**
+ * @brief Шифрование открытого текста в UTF-8 в блочный формат
+ * @param [in] plain Открытый текст в UTF-8
+ * @param [in] threads Количество потоков (0 - по числу ядер)
+ * @return Блочный текст
+ * @throw cipher_error Если текст не содержит букв
+ */
+string TableFramed::encrypt(string_view plain, unsigned threads) const
+{
+    IndexedText text = IndexedText::fromUtf8(plain);
+    const size_t n = text.size();
+    if (n == 0)
+        throwCipherError("Empty text: no valid Russian letters");
+    const size_t frames = (n + blockLetters - 1) / blockLetters;
+    string result = header();
+    result.resize(headerSize + frames * frameHeaderSize + 2 * n);
+    parallelFor(frames, parallelThreads(threads), [&](size_t k) {
+        size_t start = k * blockLetters;
+        size_t m = min(blockLetters, n - start);
+        vector<uint8_t> work(m);
+        encryptFrame(text.data() + start, m, &result[frameOffset(k)], work.data());
+    });
+    return result;
+}
+
+/**
+ * @brief Дешифрование блочного текста
+ * @param [in] framed Блочный текст
+ * @param [in] threads Количество потоков (0 - по числу ядер)
+ * @return Открытый текст в UTF-8 прописными буквами
+ * @throw cipher_error Если блочный текст невалиден
+ */
+string TableFramed::decrypt(string_view framed, unsigned threads) const
+{
+    if (framed.size() < headerSize || framed.substr(0, headerSize) != header())
+        throwCipherError("Invalid framed text");
+    const size_t body = framed.size() - headerSize;
+    if (body == 0)
+        throwCipherError("Empty cipher text");
+    // Все кадры, кроме последнего, полные, поэтому их смещения известны заранее
+    const size_t fullFrame = frameHeaderSize + 2 * blockLetters;
+    const size_t frames = (body + fullFrame - 1) / fullFrame;
+    if (body - (frames - 1) * fullFrame < frameHeaderSize)
+        throwCipherError("Invalid framed text");
+    const size_t lastLetters = getU32(framed.data() + frameOffset(frames - 1));
+    if (lastLetters == 0 || lastLetters > blockLetters
+        || (frames - 1) * fullFrame + frameHeaderSize + 2 * lastLetters != body)
+        throwCipherError("Invalid framed text");
+    for (size_t k = 0; k + 1 < frames; ++k) {
+        if (getU32(framed.data() + frameOffset(k)) != blockLetters)
+            throwCipherError("Invalid framed text");
+    }
+    const size_t n = (frames - 1) * blockLetters + lastLetters;
+    string result(2 * n, '\0');
+    parallelFor(frames, parallelThreads(threads), [&](size_t k) {
+        size_t m = k + 1 < frames ? blockLetters : lastLetters;
+        vector<uint8_t> work(2 * m);
+        decryptFrame(framed.data() + frameOffset(k) + frameHeaderSize, m, &result[2 * k * blockLetters], work.data());
+    });
+    return result;
+}
+
+/**
+ * @brief Дешифрование одного блока без чтения предыдущих
+ * @param [in] framed Блочный текст
+ * @param [in] block Номер блока
+ * @return Открытый текст блока в UTF-8
+ * @throw cipher_error Если блока нет или он невалиден
+ */
+string TableFramed::decryptBlock(string_view framed, size_t block) const
+{
+    if (framed.size() < headerSize || framed.substr(0, headerSize) != header())
+        throwCipherError("Invalid framed text");
+    const size_t offset = frameOffset(block);
+    if (offset + frameHeaderSize > framed.size())
+        throwCipherError("Invalid block number");
+    const size_t m = getU32(framed.data() + offset);
+    const size_t end = offset + frameHeaderSize + 2 * m;
+    // Неполным может быть только последний кадр
+    if (m == 0 || m > blockLetters || end > framed.size() || (m < blockLetters && end != framed.size()))
+        throwCipherError("Invalid framed text");
+    string result(2 * m, '\0');
+    vector<uint8_t> work(2 * m);
+    decryptFrame(framed.data() + offset + frameHeaderSize, m, &result[0], work.data());
+    return result;
+}
+
+/**
+ * @brief Конструктор по формату
+ * @param [in] f Параметры формата
+ * @param [in] m Направление преобразования
+ */
+TableFrameStream::TableFrameStream(const TableFramed& f, Mode m) : format(f), mode(m)
+{
+    work.resize(2 * format.blockSize());
+}
+
+/**
+ * @brief Выдача кадра
+ * @param [in] idx Номера букв блока
+ * @param [in] n Количество букв
+ * @param [in,out] out Результат, к которому добавляется кадр
+ */
+void TableFrameStream::emitFrame(const uint8_t* idx, size_t n, string& out)
+{
+    size_t pos = out.size();
+    out.resize(pos + TableFramed::frameHeaderSize + 2 * n);
+    format.encryptFrame(idx, n, &out[pos], work.data());
+    total += n;
+}
+
+/**
+ * @brief Обработка очередного фрагмента
+ * @param [in] chunk Очередной фрагмент
+ * @return Готовая часть результата
+ * @throw cipher_error Если фрагмент блочного текста невалиден
+ */
+string TableFrameStream::update(string_view chunk)
+{
+    string out;
+    pending.append(chunk.data(), chunk.size());
+    const size_t block = format.blockSize();
+    if (mode == Mode::Encrypt) {
+        if (!started) {
+            out = format.header();
+            started = true;
+        }
+        // Последний неполный символ ждет следующего фрагмента
+        size_t complete = completeUtf8(pending);
+        IndexedText text = IndexedText::fromUtf8(string_view(pending).substr(0, complete));
+        pending.erase(0, complete);
+        letters.insert(letters.end(), text.data(), text.data() + text.size());
+        size_t start = 0;
+        for (; letters.size() - start >= block; start += block)
+            emitFrame(letters.data() + start, block, out);
+        letters.erase(letters.begin(), letters.begin() + start);
+        return out;
+    }
+    size_t pos = 0;
+    if (!started) {
+        if (pending.size() < TableFramed::headerSize)
+            return out;
+        if (string_view(pending).substr(0, TableFramed::headerSize) != format.header())
+            throwCipherError("Invalid framed text");
+        pos = TableFramed::headerSize;
+        started = true;
+    }
+    while (pending.size() - pos >= TableFramed::frameHeaderSize) {
+        size_t m = getU32(pending.data() + pos);
+        if (closed || m == 0 || m > block)
+            throwCipherError("Invalid framed text");
+        if (pending.size() - pos - TableFramed::frameHeaderSize < 2 * m)
+            break;
+        size_t at = out.size();
+        out.resize(at + 2 * m);
+        format.decryptFrame(pending.data() + pos + TableFramed::frameHeaderSize, m, &out[at], work.data());
+        pos += TableFramed::frameHeaderSize + 2 * m;
+        total += m;
+        closed = m < block;
+    }
+    pending.erase(0, pos);
+    return out;
+}
+
+/**
+ * @brief Завершение потока
+ * @return Остаток результата
+ * @throw cipher_error Если текст не содержит букв или блочный текст оборван
+ */
+string TableFrameStream::finish()
+{
+    string out;
+    if (mode == Mode::Encrypt) {
+        if (total == 0 && letters.empty())
+            throwCipherError("Empty text: no valid Russian letters");
+        if (!started)
+            out = format.header();
+        if (!letters.empty())
+            emitFrame(letters.data(), letters.size(), out);
+        letters.clear();
+        pending.clear();
+        started = true;
+        return out;
+    }
+    if (!started || !pending.empty())
+        throwCipherError("Invalid framed text");
+    if (total == 0)
+        throwCipherError("Empty cipher text");
+    return out;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file modTableFramed.h
+ * @brief Заголовочный файл для блочного формата маршрутной перестановки
+ * @details Текст делится на блоки фиксированной длины, кратной числу
+ * столбцов, и каждый блок переставляется независимо. Поэтому длина всего
+ * текста не нужна заранее, память ограничена размером блока, блоки можно
+ * обрабатывать в разных потоках и читать по отдельности.
+ *
+ * Формат (числа - little-endian):
+ * @code
+ * "TBF1" | cols: uint32 | blockLetters: uint32      - заголовок, 12 байт
+ * letters: uint32 | 2 * letters байт UTF-8          - кадр, повторяется
+ * @endcode
+ * В каждом кадре, кроме последнего, letters == blockLetters; полезная
+ * нагрузка кадра совпадает с Table(cols).encrypt() для букв блока
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "modTableCipher.h"
+
+/**
+ * @brief Блочный формат табличной маршрутной перестановки
+ */
+class TableFramed
+{
+public:
+    static constexpr size_t headerSize = 12;     /**< Размер заголовка в байтах */
+    static constexpr size_t frameHeaderSize = 4; /**< Размер заголовка кадра в байтах */
+    static constexpr size_t maxBlockLetters = size_t(1) << 28; /**< Наибольшая длина блока в буквах */
+
+private:
+    Table table;         /**< Перестановка одного блока */
+    size_t blockLetters; /**< Длина блока в буквах, кратна числу столбцов */
+
+    /**
+     * @brief Проверка длины блока
+     * @param [in] cols Количество столбцов
+     * @param [in] letters Длина блока
+     * @return Валидная длина блока
+     * @throw cipher_error Если длина не кратна cols или слишком велика
+     */
+    static size_t getValidBlock(int cols, size_t letters);
+
+public:
+    /**
+     * @brief Конструктор по числу столбцов и длине блока
+     * @details Количество столбцов ограничено только длиной блока
+     * @param [in] cols Количество столбцов таблицы
+     * @param [in] letters Длина блока в буквах, кратная cols
+     * @throw cipher_error Если ключ или длина блока невалидны
+     */
+    TableFramed(int cols, size_t letters);
+
+    /**
+     * @brief Конструктор по заголовку блочного текста
+     * @param [in] framed Блочный текст, начинающийся с заголовка
+     * @return Формат с параметрами из заголовка
+     * @throw cipher_error Если заголовок невалиден
+     */
+    static TableFramed fromHeader(std::string_view framed);
+
+    /**
+     * @brief Количество столбцов
+     * @return Ключ перестановки
+     */
+    int columns() const noexcept { return table.cols; }
+
+    /**
+     * @brief Длина блока
+     * @return Количество букв в полном блоке
+     */
+    size_t blockSize() const noexcept { return blockLetters; }
+
+    /**
+     * @brief Заголовок блочного текста
+     * @return headerSize байт
+     */
+    std::string header() const;
+
+    /**
+     * @brief Смещение кадра в блочном тексте
+     * @param [in] block Номер блока
+     * @return Смещение в байтах от начала заголовка
+     */
+    size_t frameOffset(size_t block) const noexcept {
+        return headerSize + block * (frameHeaderSize + 2 * blockLetters);
+    }
+
+    /**
+     * @brief Шифрование одного блока
+     * @param [in] idx Номера букв блока
+     * @param [in] n Количество букв, 1..blockSize()
+     * @param [out] out Буфер для кадра длиной frameHeaderSize + 2 * n
+     * @param [out] work Рабочий буфер длиной не менее n
+     * @return Размер кадра в байтах
+     */
+    size_t encryptFrame(const uint8_t* idx, size_t n, char* out, uint8_t* work) const;
+
+    /**
+     * @brief Дешифрование полезной нагрузки одного кадра
+     * @param [in] payload Буквы кадра в UTF-8
+     * @param [in] n Количество букв
+     * @param [out] out Буфер для открытого текста длиной 2 * n
+     * @param [out] work Рабочий буфер длиной не менее 2 * n
+     * @throw cipher_error Если кадр содержит не-прописные буквы
+     */
+    void decryptFrame(const char* payload, size_t n, char* out, uint8_t* work) const;
+
+    /**
+     * @brief Шифрование открытого текста в UTF-8 в блочный формат
+     * @param [in] plain Открытый текст в UTF-8
+     * @param [in] threads Количество потоков (0 - по числу ядер)
+     * @return Блочный текст
+     * @throw cipher_error Если текст не содержит букв
+     */
+    std::string encrypt(std::string_view plain, unsigned threads = 1) const;
+
+    /**
+     * @brief Дешифрование блочного текста
+     * @details Заголовок должен совпадать с параметрами объекта
+     * @param [in] framed Блочный текст
+     * @param [in] threads Количество потоков (0 - по числу ядер)
+     * @return Открытый текст в UTF-8 прописными буквами
+     * @throw cipher_error Если блочный текст невалиден
+     */
+    std::string decrypt(std::string_view framed, unsigned threads = 1) const;
+
+    /**
+     * @brief Дешифрование одного блока без чтения предыдущих
+     * @param [in] framed Блочный текст
+     * @param [in] block Номер блока
+     * @return Открытый текст блока в UTF-8
+     * @throw cipher_error Если блока нет или он невалиден
+     */
+    std::string decryptBlock(std::string_view framed, size_t block) const;
+};
+
+/**
+ * @brief Потоковая обработка блочного формата с ограниченной памятью
+ * @details Принимает текст произвольными фрагментами и выдает готовые
+ * кадры (или открытый текст готовых кадров) по мере заполнения блоков.
+ * Хранится не больше одного блока
+ */
+class TableFrameStream
+{
+public:
+    /**
+     * @brief Направление преобразования
+     */
+    enum class Mode {
+        Encrypt, ///< Шифрование
+        Decrypt  ///< Дешифрование
+    };
+
+private:
+    TableFramed format;          /**< Параметры формата */
+    Mode mode;                   /**< Направление преобразования */
+    std::string pending;         /**< Необработанные байты входа */
+    std::vector<uint8_t> letters; /**< Буквы неполного блока при шифровании */
+    std::vector<uint8_t> work;   /**< Рабочий буфер блока */
+    bool started = false;        /**< Заголовок выдан или прочитан */
+    bool closed = false;         /**< Прочитан неполный последний кадр */
+    size_t total = 0;            /**< Количество обработанных букв */
+
+    /**
+     * @brief Выдача кадра
+     * @param [in] idx Номера букв блока
+     * @param [in] n Количество букв
+     * @param [in,out] out Результат, к которому добавляется кадр
+     */
+    void emitFrame(const uint8_t* idx, size_t n, std::string& out);
+
+public:
+    /**
+     * @brief Конструктор по формату
+     * @param [in] f Параметры формата
+     * @param [in] m Направление преобразования
+     */
+    TableFrameStream(const TableFramed& f, Mode m);
+
+    /**
+     * @brief Обработка очередного фрагмента
+     * @param [in] chunk Очередной фрагмент
+     * @return Готовая часть результата
+     * @throw cipher_error Если фрагмент блочного текста невалиден
+     */
+    std::string update(std::string_view chunk);
+
+    /**
+     * @brief Завершение потока
+     * @details При шифровании выдает последний неполный кадр
+     * @return Остаток результата
+     * @throw cipher_error Если текст не содержит букв или блочный текст оборван
+     */
+    std::string finish();
+};
@@ -0,0 +1,198 @@
+/**
+ * @file modTablePlan.cpp
+ * @brief Реализация плана перестановки TablePlan и кэша планов
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include "modTablePlan.h"
+#include "modTableCipher.h"
+#include "modTranspose.h"
+#include <algorithm>
+
+/**
+ * @brief Построение плана
+ * @param [in] cols Количество столбцов таблицы
+ * @param [in] n Длина текста
+ * @throw cipher_error Если текст слишком длинный
+ */
+TablePlan::TablePlan(size_t cols, size_t n) : planKeys{static_cast<int>(cols)}, planLength(n)
+{
+    if (n > UINT32_MAX)
+        throwCipherError("Text too long for a transposition plan");
+    gather.resize(n);
+    cols = transpose_detail::usedCols(n, cols);
+    size_t rows = (n + cols - 1) / cols;
+    size_t fullCols = n % cols;
+    if (fullCols == 0) fullCols = cols;
+    size_t k = 0;
+    for (size_t col = cols; col-- > 0; ) {
+        size_t rowsInCol = col < fullCols ? rows : rows - 1;
+        for (size_t row = 0; row < rowsInCol; row++)
+            gather[k++] = static_cast<uint32_t>(row * cols + col);
+    }
+}
+
+/**
+ * @brief Построение составного плана нескольких раундов
+ * @param [in] keys Количество столбцов в каждом раунде
+ * @param [in] n Длина текста
+ * @throw cipher_error Если текст слишком длинный
+ */
+TablePlan::TablePlan(const std::vector<int>& keys, size_t n) : planKeys(keys), planLength(n)
+{
+    if (n > UINT32_MAX)
+        throwCipherError("Text too long for a transposition plan");
+    // Индексы открытого текста, переставленные всеми раундами, - это индексы сбора
+    std::vector<uint32_t> identity(n);
+    for (size_t k = 0; k < n; k++)
+        identity[k] = static_cast<uint32_t>(k);
+    gather.resize(n);
+    readRounds(identity.data(), n, keys, gather.data());
+}
+
+/**
+ * @brief Создание пустого кэша
+ * @param [in] cap Наибольшее число хранимых планов
+ * @param [in] bytes Наибольший суммарный размер планов в байтах
+ */
+TablePlanCache::TablePlanCache(size_t cap, size_t bytes)
+    : capacity(cap), budget(bytes), snapshot(std::make_shared<const Snapshot>())
+{
+    clearMisses();
+}
+
+/**
+ * @brief Очистка истории промахов
+ */
+void TablePlanCache::clearMisses()
+{
+    for (auto& m : misses)
+        m.store(SIZE_MAX, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Присваивание очищает кэш
+ * @param [in] other Исходный кэш
+ * @return Ссылка на этот кэш
+ */
+TablePlanCache& TablePlanCache::operator=(const TablePlanCache& other)
+{
+    if (this != &other) {
+        std::lock_guard<std::mutex> guard(publish);
+        capacity = other.capacity;
+        budget = other.budget;
+        std::atomic_store(&snapshot, std::make_shared<const Snapshot>());
+        clearMisses();
+    }
+    return *this;
+}
+
+/**
+ * @brief Поиск плана в текущем снимке
+ * @param [in] keys Количество столбцов в каждом раунде
+ * @param [in] rounds Количество раундов
+ * @param [in] n Длина текста
+ * @return План или nullptr
+ */
+std::shared_ptr<const TablePlan> TablePlanCache::find(const int* keys, size_t rounds, size_t n)
+{
+    std::shared_ptr<const Snapshot> current = std::atomic_load(&snapshot);
+    for (const auto& slot : *current) {
+        const std::vector<int>& planKeys = slot->plan->keys();
+        if (slot->plan->length() == n && planKeys.size() == rounds
+                && std::equal(planKeys.begin(), planKeys.end(), keys)) {
+            // Запись только при смене поколения, чтобы не перебрасывать строку кэша
+            uint64_t now = generation.load(std::memory_order_relaxed);
+            if (slot->used.load(std::memory_order_relaxed) != now)
+                slot->used.store(now, std::memory_order_relaxed);
+            return slot->plan;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Публикация снимка с новым планом
+ * @param [in] plan Построенный план
+ * @return Добавленный план или такой же, добавленный другим потоком
+ */
+std::shared_ptr<const TablePlan> TablePlanCache::insert(std::shared_ptr<const TablePlan> plan)
+{
+    if (capacity == 0 || plan->bytes() > budget)
+        return plan;
+    std::lock_guard<std::mutex> guard(publish);
+    std::shared_ptr<const Snapshot> current = std::atomic_load(&snapshot);
+    for (const auto& slot : *current) {
+        if (slot->plan->length() == plan->length() && slot->plan->keys() == plan->keys())
+            return slot->plan;
+    }
+    auto next = std::make_shared<Snapshot>(*current);
+    auto slot = std::make_shared<Slot>();
+    slot->plan = plan;
+    slot->used.store(generation.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    next->insert(next->begin(), slot);
+    size_t total = 0;
+    for (const auto& s : *next)
+        total += s->plan->bytes();
+    // Вытеснение давно не использованных планов, новый план остается
+    while (next->size() > capacity || total > budget) {
+        auto oldest = std::min_element(next->begin() + 1, next->end(), [](const auto& a, const auto& b) {
+            return a->used.load(std::memory_order_relaxed) < b->used.load(std::memory_order_relaxed);
+        });
+        total -= (*oldest)->plan->bytes();
+        next->erase(oldest);
+    }
+    std::atomic_store(&snapshot, std::shared_ptr<const Snapshot>(std::move(next)));
+    return plan;
+}
+
+/**
+ * @brief Получение плана из кэша или построение нового
+ * @param [in] cols Количество столбцов таблицы
+ * @param [in] n Длина текста
+ * @return План перестановки
+ */
+std::shared_ptr<const TablePlan> TablePlanCache::get(size_t cols, size_t n)
+{
+    // Ключ сравнивается без временного вектора, чтобы попадание не выделяло память
+    const int key = static_cast<int>(cols);
+    if (auto plan = find(&key, 1, n))
+        return plan;
+    return insert(std::make_shared<const TablePlan>(cols, n));
+}
+
+/**
+ * @brief Получение составного плана из кэша или построение нового
+ * @param [in] keys Количество столбцов в каждом раунде
+ * @param [in] n Длина текста
+ * @return План перестановки
+ */
+std::shared_ptr<const TablePlan> TablePlanCache::get(const std::vector<int>& keys, size_t n)
+{
+    if (auto plan = find(keys.data(), keys.size(), n))
+        return plan;
+    return insert(std::make_shared<const TablePlan>(keys, n));
+}
+
+/**
+ * @brief Получение плана только для повторяющейся длины
+ * @param [in] keys Количество столбцов в каждом раунде
+ * @param [in] n Длина текста
+ * @return План перестановки или nullptr
+ */
+std::shared_ptr<const TablePlan> TablePlanCache::getRepeated(const std::vector<int>& keys, size_t n)
+{
+    if (auto plan = find(keys.data(), keys.size(), n))
+        return plan;
+    // Слишком длинному тексту план не нужен: вызывающий переставляет без него
+    if (capacity == 0 || n > UINT32_MAX || n > budget / sizeof(uint32_t))
+        return nullptr;
+    for (const auto& m : misses) {
+        if (m.load(std::memory_order_relaxed) == n)
+            return insert(std::make_shared<const TablePlan>(keys, n));
+    }
+    misses[nextMiss.fetch_add(1, std::memory_order_relaxed) % missHistory].store(n, std::memory_order_relaxed);
+    return nullptr;
+}
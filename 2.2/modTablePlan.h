@@ -0,0 +1,208 @@
+/**
+ * @file modTablePlan.h
+ * @brief Заголовочный файл для плана перестановки TablePlan
+ * @details Предвычисленные индексы табличной маршрутной перестановки для
+ * заданных ключей (одного или нескольких раундов) и длины текста и
+ * кэш планов, ограниченный числом планов и их суммарным размером
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief План табличной маршрутной перестановки
+ * @details Хранит для каждой позиции шифротекста индекс буквы открытого
+ * текста, поэтому шифрование сводится к одному проходу сбора, а
+ * дешифрование - к одному проходу рассылки без вычисления индексов.
+ * Несколько раундов перестановки объединяются в один план
+ */
+class TablePlan
+{
+private:
+    std::vector<int> planKeys;     /**< Количество столбцов в каждом раунде */
+    size_t planLength;             /**< Длина текста */
+    std::vector<uint32_t> gather;  /**< Индекс открытого текста для каждой позиции шифротекста */
+    
+public:
+    /**
+     * @brief Построение плана
+     * @param [in] cols Количество столбцов таблицы
+     * @param [in] n Длина текста
+     * @throw cipher_error Если текст длиннее 2^32 - 1 букв
+     */
+    TablePlan(size_t cols, size_t n);
+    
+    /**
+     * @brief Построение составного плана нескольких раундов
+     * @details Раунды применяются при шифровании в порядке следования
+     * ключей; индексы раундов объединяются в одну перестановку
+     * @param [in] keys Количество столбцов в каждом раунде (не пусто)
+     * @param [in] n Длина текста
+     * @throw cipher_error Если текст длиннее 2^32 - 1 букв
+     */
+    TablePlan(const std::vector<int>& keys, size_t n);
+    
+    /**
+     * @brief Ключи раундов плана
+     * @return Количество столбцов в каждом раунде
+     */
+    const std::vector<int>& keys() const { return planKeys; }
+    
+    /**
+     * @brief Длина текста, для которой построен план
+     * @return Длина текста
+     */
+    size_t length() const { return planLength; }
+    
+    /**
+     * @brief Индексы сбора
+     * @return Индекс открытого текста для каждой позиции шифротекста
+     */
+    const std::vector<uint32_t>& indices() const { return gather; }
+    
+    /**
+     * @brief Размер индексов плана
+     * @return Размер в байтах
+     */
+    size_t bytes() const { return gather.size() * sizeof(uint32_t); }
+    
+    /**
+     * @brief Перестановка открытого текста в шифротекст
+     * @param [in] src Открытый текст длиной length()
+     * @param [out] dst Буфер для шифротекста длиной length()
+     */
+    template <class T>
+    void encrypt(const T* src, T* dst) const
+    {
+        const uint32_t* g = gather.data();
+        for (size_t k = 0; k < planLength; k++)
+            dst[k] = src[g[k]];
+    }
+    
+    /**
+     * @brief Обратная перестановка шифротекста в открытый текст
+     * @param [in] src Шифротекст длиной length()
+     * @param [out] dst Буфер для открытого текста длиной length()
+     */
+    template <class T>
+    void decrypt(const T* src, T* dst) const
+    {
+        const uint32_t* g = gather.data();
+        for (size_t k = 0; k < planLength; k++)
+            dst[g[k]] = src[k];
+    }
+};
+
+/**
+ * @brief Ограниченный кэш планов перестановки
+ * @details Хранит не более capacity планов суммарным размером не более
+ * budget байтов; план больше budget не кэшируется. Поиск читает
+ * неизменяемый снимок списка планов и не берет мьютекс. План строится
+ * вне мьютекса, мьютекс защищает только публикацию нового снимка, при
+ * которой вытесняются давно не использованные планы. При копировании
+ * кэш не копируется
+ */
+class TablePlanCache
+{
+private:
+    /**
+     * @brief Запись кэша
+     */
+    struct Slot {
+        std::shared_ptr<const TablePlan> plan; /**< План */
+        std::atomic<uint64_t> used{0};         /**< Поколение последнего использования */
+    };
+    /// Неизменяемый список записей
+    using Snapshot = std::vector<std::shared_ptr<Slot>>;
+    /// Количество запоминаемых длин промахов
+    static constexpr size_t missHistory = 8;
+    
+    size_t capacity;                          /**< Наибольшее число планов */
+    size_t budget;                            /**< Наибольший суммарный размер планов в байтах */
+    std::shared_ptr<const Snapshot> snapshot; /**< Текущий список; читается через std::atomic_load */
+    std::atomic<uint64_t> generation{0};      /**< Счетчик публикаций снимка */
+    std::array<std::atomic<size_t>, missHistory> misses; /**< Длины последних промахов getRepeated() */
+    std::atomic<size_t> nextMiss{0};          /**< Следующая ячейка misses */
+    std::mutex publish;                       /**< Защита публикации снимка */
+    
+    /**
+     * @brief Поиск плана в текущем снимке
+     * @param [in] keys Количество столбцов в каждом раунде
+     * @param [in] rounds Количество раундов
+     * @param [in] n Длина текста
+     * @return План или nullptr
+     */
+    std::shared_ptr<const TablePlan> find(const int* keys, size_t rounds, size_t n);
+    
+    /**
+     * @brief Публикация снимка с новым планом
+     * @param [in] plan Построенный план
+     * @return Добавленный план или такой же, добавленный другим потоком
+     */
+    std::shared_ptr<const TablePlan> insert(std::shared_ptr<const TablePlan> plan);
+    
+    /**
+     * @brief Очистка истории промахов
+     */
+    void clearMisses();
+    
+public:
+    /**
+     * @brief Создание пустого кэша
+     * @param [in] cap Наибольшее число хранимых планов
+     * @param [in] bytes Наибольший суммарный размер планов в байтах
+     */
+    TablePlanCache(size_t cap, size_t bytes);
+    
+    /**
+     * @brief Копирование создает пустой кэш с теми же ограничениями
+     * @param [in] other Исходный кэш
+     */
+    TablePlanCache(const TablePlanCache& other) : TablePlanCache(other.capacity, other.budget) {}
+    
+    /**
+     * @brief Присваивание очищает кэш
+     * @details Нельзя вызывать параллельно с другими методами
+     * @param [in] other Исходный кэш
+     * @return Ссылка на этот кэш
+     */
+    TablePlanCache& operator=(const TablePlanCache& other);
+    
+    /**
+     * @brief Получение плана из кэша или построение нового
+     * @param [in] cols Количество столбцов таблицы
+     * @param [in] n Длина текста
+     * @return План перестановки
+     */
+    std::shared_ptr<const TablePlan> get(size_t cols, size_t n);
+    
+    /**
+     * @brief Получение составного плана из кэша или построение нового
+     * @param [in] keys Количество столбцов в каждом раунде
+     * @param [in] n Длина текста
+     * @return План перестановки
+     */
+    std::shared_ptr<const TablePlan> get(const std::vector<int>& keys, size_t n);
+    
+    /**
+     * @brief Получение плана только для повторяющейся длины
+     * @details При первом промахе длина запоминается и возвращается
+     * nullptr, план строится, только если та же длина встретилась среди
+     * последних промахов. Подходит для вызывающих, которым план нужен
+     * лишь для ускорения повторных длин. Для длины больше UINT32_MAX
+     * или больше ограничения размера кэша всегда возвращается nullptr
+     * @param [in] keys Количество столбцов в каждом раунде
+     * @param [in] n Длина текста
+     * @return План перестановки или nullptr
+     */
+    std::shared_ptr<const TablePlan> getRepeated(const std::vector<int>& keys, size_t n);
+};
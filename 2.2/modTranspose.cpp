@@ -0,0 +1,131 @@
+/**
+ * @file modTranspose.cpp
+ * @brief Реализация транспонирования 32-битных плиток 8x8
+ * @details Используется AVX2 при его наличии во время выполнения
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include "modTranspose.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TRANSPOSE_X86 1
+#endif
+
+namespace transpose_detail {
+
+#if defined(TRANSPOSE_X86)
+namespace {
+
+/**
+ * @brief Транспонирование восьми регистров по восемь 32-битных элементов
+ * @param [in,out] v Строки на входе, столбцы на выходе
+ */
+__attribute__((target("avx2")))
+inline void transpose8x8(__m256i* v)
+{
+    __m256i t0 = _mm256_unpacklo_epi32(v[0], v[1]);
+    __m256i t1 = _mm256_unpackhi_epi32(v[0], v[1]);
+    __m256i t2 = _mm256_unpacklo_epi32(v[2], v[3]);
+    __m256i t3 = _mm256_unpackhi_epi32(v[2], v[3]);
+    __m256i t4 = _mm256_unpacklo_epi32(v[4], v[5]);
+    __m256i t5 = _mm256_unpackhi_epi32(v[4], v[5]);
+    __m256i t6 = _mm256_unpacklo_epi32(v[6], v[7]);
+    __m256i t7 = _mm256_unpackhi_epi32(v[6], v[7]);
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+    v[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    v[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    v[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    v[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    v[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    v[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    v[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    v[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+}
+
+/**
+ * @brief Наличие AVX2 для транспонирования 32-битных плиток
+ * @return true, если процессор поддерживает AVX2
+ */
+bool haveTiles32()
+{
+    static const bool avx2 = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return avx2;
+}
+
+/**
+ * @brief Чтение по столбцам плитками 8x8 (AVX2)
+ */
+__attribute__((target("avx2")))
+void readTiles32(const void* src, size_t cols, const size_t* colStart, void* dst,
+                 size_t r0, size_t r1, size_t cols8)
+{
+    const char* s = static_cast<const char*>(src);
+    char* d = static_cast<char*>(dst);
+    __m256i v[8];
+    for (size_t rb = r0; rb < r1; rb += 16) {
+        size_t re = rb + 16 < r1 ? rb + 16 : r1;
+        for (size_t c = 0; c < cols8; c += 8) {
+            for (size_t r = rb; r < re; r += 8) {
+                for (size_t i = 0; i < 8; i++)
+                    v[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 4 * ((r + i) * cols + c)));
+                transpose8x8(v);
+                for (size_t j = 0; j < 8; j++)
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 4 * (colStart[c + j] + r)), v[j]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Запись по столбцам плитками 8x8 (AVX2)
+ */
+__attribute__((target("avx2")))
+void writeTiles32(const void* src, size_t cols, const size_t* colStart, void* dst,
+                  size_t r0, size_t r1, size_t cols8)
+{
+    const char* s = static_cast<const char*>(src);
+    char* d = static_cast<char*>(dst);
+    __m256i v[8];
+    for (size_t rb = r0; rb < r1; rb += 16) {
+        size_t re = rb + 16 < r1 ? rb + 16 : r1;
+        for (size_t c = 0; c < cols8; c += 8) {
+            for (size_t r = rb; r < re; r += 8) {
+                for (size_t j = 0; j < 8; j++)
+                    v[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 4 * (colStart[c + j] + r)));
+                transpose8x8(v);
+                for (size_t i = 0; i < 8; i++)
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 4 * ((r + i) * cols + c)), v[i]);
+            }
+        }
+    }
+}
+
+#else
+
+bool haveTiles32()
+{
+    return false;
+}
+
+void readTiles32(const void*, size_t, const size_t*, void*, size_t, size_t, size_t) {}
+
+void writeTiles32(const void*, size_t, const size_t*, void*, size_t, size_t, size_t) {}
+
+#endif
+
+}
@@ -0,0 +1,422 @@
+/**
+ * @file modTranspose.h
+ * @brief Заголовочный файл ядер табличной перестановки
+ * @details Чтение и запись таблицы по столбцам справа налево без
+ * промежуточной таблицы. Для больших текстов используется блочный обход
+ * плитками, помещающимися в кэш L1, а для 32-битных символов при наличии
+ * AVX2 - транспонирование плиток 8x8 в регистрах. Полосы строк независимы,
+ * поэтому блочный обход можно распределить по потокам
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+#include "../common/modParallel.h"
+
+/// Длина текста, начиная с которой используется блочный обход
+constexpr size_t transposeThreshold = 1 << 15;
+
+/**
+ * @brief Вспомогательные функции ядер перестановки
+ */
+namespace transpose_detail {
+
+/// Сторона плитки блочного обхода
+constexpr size_t tile = 16;
+
+/**
+ * @brief Количество столбцов, участвующих в перестановке
+ * @details При cols >= n таблица состоит из одной строки, а столбцы
+ * правее n-го пусты, поэтому перестановка совпадает с cols = n. Разметка
+ * и обход по столбцам строятся для этого числа, и память не зависит от cols
+ * @param [in] n Длина текста
+ * @param [in] cols Количество столбцов
+ * @return min(cols, n) или cols для пустого текста
+ */
+inline size_t usedCols(size_t n, size_t cols)
+{
+    return n != 0 && cols > n ? n : cols;
+}
+
+/**
+ * @brief Разметка таблицы для текста длины n
+ * @details Первые fullCols столбцов содержат rows элементов, остальные -
+ * rows - 1. Столбец col начинается в шифротексте с позиции colStart[col]
+ */
+struct Layout {
+    size_t rows;                  ///< Количество строк
+    size_t fullCols;              ///< Количество столбцов полной высоты
+    size_t fullRows;              ///< Количество полностью заполненных строк
+    std::pmr::vector<size_t> colStart; ///< Начало каждого столбца в шифротексте
+
+    /**
+     * @brief Построение разметки
+     * @param [in] n Длина текста
+     * @param [in] cols Количество столбцов
+     * @param [in] mr Источник памяти для colStart
+     */
+    Layout(size_t n, size_t cols, std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : colStart(cols, mr) {
+        rows = (n + cols - 1) / cols;
+        fullCols = n % cols;
+        if (fullCols == 0) fullCols = cols;
+        fullRows = fullCols == cols ? rows : rows - 1;
+        size_t start = 0;
+        for (size_t col = cols; col-- > 0; ) {
+            colStart[col] = start;
+            start += col < fullCols ? rows : rows - 1;
+        }
+    }
+};
+
+/**
+ * @brief Наличие AVX2 для транспонирования 32-битных плиток
+ * @return true, если процессор поддерживает AVX2
+ */
+bool haveTiles32();
+
+/**
+ * @brief Чтение по столбцам плитками 8x8 для 32-битных элементов (AVX2)
+ * @details Обрабатывает строки [r0, r1) и столбцы [0, cols8); r1 - r0 и
+ * cols8 кратны 8
+ * @param [in] src Текст, записанный по строкам
+ * @param [in] cols Количество столбцов
+ * @param [in] colStart Начала столбцов в шифротексте
+ * @param [out] dst Шифротекст
+ * @param [in] r0 Первая обрабатываемая строка
+ * @param [in] r1 Граница обрабатываемых строк
+ * @param [in] cols8 Граница обрабатываемых столбцов
+ */
+void readTiles32(const void* src, size_t cols, const size_t* colStart, void* dst,
+                 size_t r0, size_t r1, size_t cols8);
+
+/**
+ * @brief Запись по столбцам плитками 8x8 для 32-битных элементов (AVX2)
+ * @details Обратное преобразование к readTiles32()
+ * @param [in] src Шифротекст
+ * @param [in] cols Количество столбцов
+ * @param [in] colStart Начала столбцов в шифротексте
+ * @param [out] dst Текст, записанный по строкам
+ * @param [in] r0 Первая обрабатываемая строка
+ * @param [in] r1 Граница обрабатываемых строк
+ * @param [in] cols8 Граница обрабатываемых столбцов
+ */
+void writeTiles32(const void* src, size_t cols, const size_t* colStart, void* dst,
+                  size_t r0, size_t r1, size_t cols8);
+
+/**
+ * @brief Простое чтение по столбцам
+ */
+template <class T>
+void readSimple(const T* src, size_t n, size_t cols, T* dst)
+{
+    size_t rows = (n + cols - 1) / cols;
+    size_t fullCols = n % cols;
+    if (fullCols == 0) fullCols = cols;
+    for (size_t col = cols; col-- > 0; ) {
+        size_t rowsInCol = col < fullCols ? rows : rows - 1;
+        const T* p = src + col;
+        for (size_t row = 0; row < rowsInCol; row++, p += cols)
+            *dst++ = *p;
+    }
+}
+
+/**
+ * @brief Простая запись по столбцам
+ */
+template <class T>
+void writeSimple(const T* src, size_t n, size_t cols, T* dst)
+{
+    size_t rows = (n + cols - 1) / cols;
+    size_t fullCols = n % cols;
+    if (fullCols == 0) fullCols = cols;
+    for (size_t col = cols; col-- > 0; ) {
+        size_t rowsInCol = col < fullCols ? rows : rows - 1;
+        T* p = dst + col;
+        for (size_t row = 0; row < rowsInCol; row++, p += cols)
+            *p = *src++;
+    }
+}
+
+/**
+ * @brief Блочное чтение прямоугольника [r0, r1) x [c0, c1) полных строк
+ */
+template <class T>
+void readRect(const T* src, size_t cols, const size_t* colStart, T* dst,
+              size_t r0, size_t r1, size_t c0, size_t c1)
+{
+    for (size_t rb = r0; rb < r1; rb += tile) {
+        size_t re = rb + tile < r1 ? rb + tile : r1;
+        for (size_t cb = c0; cb < c1; cb += tile) {
+            size_t ce = cb + tile < c1 ? cb + tile : c1;
+            for (size_t c = cb; c < ce; c++) {
+                T* d = dst + colStart[c];
+                for (size_t r = rb; r < re; r++)
+                    d[r] = src[r * cols + c];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Блочная запись прямоугольника [r0, r1) x [c0, c1) полных строк
+ */
+template <class T>
+void writeRect(const T* src, size_t cols, const size_t* colStart, T* dst,
+               size_t r0, size_t r1, size_t c0, size_t c1)
+{
+    for (size_t rb = r0; rb < r1; rb += tile) {
+        size_t re = rb + tile < r1 ? rb + tile : r1;
+        for (size_t cb = c0; cb < c1; cb += tile) {
+            size_t ce = cb + tile < c1 ? cb + tile : c1;
+            for (size_t r = rb; r < re; r++) {
+                T* d = dst + r * cols;
+                for (size_t c = cb; c < ce; c++)
+                    d[c] = src[colStart[c] + r];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Блочное чтение полос полных строк [r0, r1)
+ */
+template <class T>
+void readRows(const T* src, size_t cols, const Layout& l, T* dst, size_t r0, size_t r1)
+{
+    size_t rows8 = r0, cols8 = 0;
+    if (sizeof(T) == 4 && haveTiles32()) {
+        rows8 = r0 + ((r1 - r0) & ~size_t(7));
+        cols8 = cols & ~size_t(7);
+        readTiles32(src, cols, l.colStart.data(), dst, r0, rows8, cols8);
+    }
+    readRect(src, cols, l.colStart.data(), dst, r0, rows8, cols8, cols);
+    readRect(src, cols, l.colStart.data(), dst, rows8, r1, 0, cols);
+}
+
+/**
+ * @brief Блочная запись полос полных строк [r0, r1)
+ */
+template <class T>
+void writeRows(const T* src, size_t cols, const Layout& l, T* dst, size_t r0, size_t r1)
+{
+    size_t rows8 = r0, cols8 = 0;
+    if (sizeof(T) == 4 && haveTiles32()) {
+        rows8 = r0 + ((r1 - r0) & ~size_t(7));
+        cols8 = cols & ~size_t(7);
+        writeTiles32(src, cols, l.colStart.data(), dst, r0, rows8, cols8);
+    }
+    writeRect(src, cols, l.colStart.data(), dst, r0, rows8, cols8, cols);
+    writeRect(src, cols, l.colStart.data(), dst, rows8, r1, 0, cols);
+}
+
+/**
+ * @brief Блочное чтение по столбцам полосами строк на нескольких потоках
+ * @param [in] threads Количество потоков (1 - в вызывающем потоке)
+ * @param [in] mr Источник памяти для разметки
+ */
+template <class T>
+void readBlocked(const T* src, size_t n, size_t cols, T* dst, unsigned threads = 1,
+                 std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+{
+    Layout l(n, cols, mr);
+    size_t band = (l.fullRows + threads - 1) / threads;
+    band = (band + tile - 1) / tile * tile;
+    size_t bands = band == 0 ? 0 : (l.fullRows + band - 1) / band;
+    parallelFor(bands, threads, [&](size_t b) {
+        readRows(src, cols, l, dst, b * band, (b + 1) * band < l.fullRows ? (b + 1) * band : l.fullRows);
+    });
+    // Неполная последняя строка
+    for (size_t c = 0; l.fullRows < l.rows && c < l.fullCols; c++)
+        dst[l.colStart[c] + l.fullRows] = src[l.fullRows * cols + c];
+}
+
+/**
+ * @brief Блочная запись по столбцам полосами строк на нескольких потоках
+ * @param [in] threads Количество потоков (1 - в вызывающем потоке)
+ * @param [in] mr Источник памяти для разметки
+ */
+template <class T>
+void writeBlocked(const T* src, size_t n, size_t cols, T* dst, unsigned threads = 1,
+                  std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+{
+    Layout l(n, cols, mr);
+    size_t band = (l.fullRows + threads - 1) / threads;
+    band = (band + tile - 1) / tile * tile;
+    size_t bands = band == 0 ? 0 : (l.fullRows + band - 1) / band;
+    parallelFor(bands, threads, [&](size_t b) {
+        writeRows(src, cols, l, dst, b * band, (b + 1) * band < l.fullRows ? (b + 1) * band : l.fullRows);
+    });
+    for (size_t c = 0; l.fullRows < l.rows && c < l.fullCols; c++)
+        dst[l.fullRows * cols + c] = src[l.colStart[c] + l.fullRows];
+}
+
+}
+
+/**
+ * @brief Чтение таблицы по столбцам справа налево
+ * @details Элемент (row, col) таблицы, заполненной по строкам, находится
+ * по индексу row * cols + col. Первые fullCols столбцов содержат rows
+ * элементов, остальные - rows - 1, поэтому заполнитель не нужен. Начиная
+ * с transposeThreshold элементов включается блочный обход. Память и время
+ * пропорциональны n при любом cols
+ * @param [in] src Текст, записанный в таблицу по строкам
+ * @param [in] n Длина текста
+ * @param [in] cols Количество столбцов
+ * @param [out] dst Буфер для результата длиной n
+ * @param [in] mr Источник памяти для разметки блочного обхода
+ */
+template <class T>
+void readColumns(const T* src, size_t n, size_t cols, T* dst,
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+{
+    cols = transpose_detail::usedCols(n, cols);
+    if (n < transposeThreshold || cols == 1)
+        transpose_detail::readSimple(src, n, cols, dst);
+    else
+        transpose_detail::readBlocked(src, n, cols, dst, 1, mr);
+}
+
+/**
+ * @brief Запись таблицы по столбцам справа налево
+ * @details Обратное преобразование к readColumns()
+ * @param [in] src Текст, прочитанный из таблицы по столбцам
+ * @param [in] n Длина текста
+ * @param [in] cols Количество столбцов
+ * @param [out] dst Буфер для результата длиной n
+ * @param [in] mr Источник памяти для разметки блочного обхода
+ */
+template <class T>
+void writeColumns(const T* src, size_t n, size_t cols, T* dst,
+         std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+{
+    cols = transpose_detail::usedCols(n, cols);
+    if (n < transposeThreshold || cols == 1)
+        transpose_detail::writeSimple(src, n, cols, dst);
+    else
+        transpose_detail::writeBlocked(src, n, cols, dst, 1, mr);
+}
+
+/**
+ * @brief Параллельное чтение таблицы по столбцам справа налево
+ * @details Полные строки делятся на полосы, каждая полоса записывает свою
+ * часть каждого столбца шифротекста, начало которого известно из rows и
+ * fullCols. Для коротких текстов выполняется в вызывающем потоке
+ * @param [in] src Текст, записанный в таблицу по строкам
+ * @param [in] n Длина текста
+ * @param [in] cols Количество столбцов
+ * @param [out] dst Буфер для результата длиной n
+ * @param [in] threads Количество потоков
+ */
+template <class T>
+void readColumnsParallel(const T* src, size_t n, size_t cols, T* dst, unsigned threads)
+{
+    cols = transpose_detail::usedCols(n, cols);
+    if (n < transposeThreshold || cols == 1 || threads <= 1)
+        readColumns(src, n, cols, dst);
+    else
+        transpose_detail::readBlocked(src, n, cols, dst, threads);
+}
+
+/**
+ * @brief Параллельная запись таблицы по столбцам справа налево
+ * @details Обратное преобразование к readColumnsParallel()
+ * @param [in] src Текст, прочитанный из таблицы по столбцам
+ * @param [in] n Длина текста
+ * @param [in] cols Количество столбцов
+ * @param [out] dst Буфер для результата длиной n
+ * @param [in] threads Количество потоков
+ */
+template <class T>
+void writeColumnsParallel(const T* src, size_t n, size_t cols, T* dst, unsigned threads)
+{
+    cols = transpose_detail::usedCols(n, cols);
+    if (n < transposeThreshold || cols == 1 || threads <= 1)
+        writeColumns(src, n, cols, dst);
+    else
+        transpose_detail::writeBlocked(src, n, cols, dst, threads);
+}
+
+/**
+ * @brief Обход позиций шифротекста для участка открытого текста
+ * @details Буква открытого текста p стоит в строке p / cols и столбце
+ * col = p % cols. Столбцы читаются справа налево, поэтому столбец col
+ * начинается в шифротексте с позиции
+ * (cols - 1 - col) * (rows - 1) + max(0, fullCols - 1 - col).
+ * Время O(len) при любых n и cols, дополнительная память не нужна
+ * @param [in] n Длина текста
+ * @param [in] cols Количество столбцов
+ * @param [in] pos Позиция первой буквы участка, pos + len <= n
+ * @param [in] len Количество букв участка
+ * @param [in] f Вызывается как f(k, i) для буквы участка k и ее позиции i в шифротексте
+ */
+template <class F>
+void columnRange(size_t n, size_t cols, size_t pos, size_t len, F&& f)
+{
+    if (len == 0)
+        return;
+    cols = transpose_detail::usedCols(n, cols);
+    size_t rows = (n + cols - 1) / cols;
+    size_t fullCols = n % cols;
+    if (fullCols == 0) fullCols = cols;
+    size_t row = pos / cols;
+    size_t col = pos % cols;
+    for (size_t k = 0; k < len; k++) {
+        size_t start = (cols - 1 - col) * (rows - 1) + (fullCols > col + 1 ? fullCols - 1 - col : 0);
+        f(k, start + row);
+        if (++col == cols) {
+            col = 0;
+            row++;
+        }
+    }
+}
+
+/**
+ * @brief Несколько раундов чтения по столбцам
+ * @details Раунды выполняются подряд ядром readColumns(), промежуточный
+ * текст чередуется между dst и одним временным буфером, поэтому каждый
+ * раунд - один блочный проход без проверки и копирования текста
+ * @param [in] src Открытый текст
+ * @param [in] n Длина текста
+ * @param [in] keys Количество столбцов в каждом раунде в порядке шифрования
+ * @param [out] dst Буфер для шифротекста длиной n, не совпадающий с src
+ * @param [in] mr Источник памяти для временного буфера и разметки
+ */
+template <class T>
+void readRounds(const T* src, size_t n, const std::vector<int>& keys, T* dst,
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+{
+    std::pmr::vector<T> tmp(keys.size() > 1 ? n : 0, mr);
+    for (size_t r = 0; r < keys.size(); r++) {
+        // Последний раунд пишет в dst
+        T* out = (keys.size() - 1 - r) % 2 == 0 ? dst : tmp.data();
+        readColumns(src, n, keys[r], out, mr);
+        src = out;
+    }
+}
+
+/**
+ * @brief Несколько раундов записи по столбцам
+ * @details Обратное преобразование к readRounds(): раунды выполняются в
+ * обратном порядке
+ * @param [in] src Шифротекст
+ * @param [in] n Длина текста
+ * @param [in] keys Количество столбцов в каждом раунде в порядке шифрования
+ * @param [out] dst Буфер для открытого текста длиной n, не совпадающий с src
+ * @param [in] mr Источник памяти для временного буфера и разметки
+ */
+template <class T>
+void writeRounds(const T* src, size_t n, const std::vector<int>& keys, T* dst,
+         std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+{
+    std::pmr::vector<T> tmp(keys.size() > 1 ? n : 0, mr);
+    for (size_t r = keys.size(); r-- > 0; ) {
+        T* out = r % 2 == 0 ? dst : tmp.data();
+        writeColumns(src, n, keys[r], out, mr);
+        src = out;
+    }
+}
@@ -8,10 +8,18 @@
  */
 
 #include <UnitTest++/UnitTest++.h>
+#include <algorithm>
 #include <string>
 #include <locale>
 #include <codecvt>
+#include <vector>
+#include <memory_resource>
+#include <atomic>
+#include <thread>
 #include "modTableCipher.h"
+#include "modTableFixed.h"
+#include "modTableFramed.h"
+#include "modTranspose.h"
 
 using namespace std;
 
@@ -54,6 +62,18 @@ SUITE(ConstructorTest)
         CHECK_WIDE_EQUAL(L"ИТРРЕИПВМ", cipher.encrypt(L"ПРИВЕТМИР"));
     }
     
+    /**
+     * @brief Тест смены количества столбцов
+     */
+    TEST(SetCols) {
+        Table cipher(5);
+        cipher.encrypt(L"ПРИВЕТМИР");
+        cipher.setCols(3);
+        CHECK_WIDE_EQUAL(L"ИТРРЕИПВМ", cipher.encrypt(L"ПРИВЕТМИР"));
+        CHECK_THROW(cipher.setCols(0), cipher_error);
+        CHECK_WIDE_EQUAL(L"ИТРРЕИПВМ", cipher.encrypt(L"ПРИВЕТМИР"));
+    }
+    
     /**
      * @brief Тест длинного ключа
      */
@@ -83,6 +103,20 @@ SUITE(ConstructorTest)
     TEST(ZeroKey) {
         CHECK_THROW(Table cipher(0), cipher_error);
     }
+    
+    /**
+     * @brief Тест заданного предела количества столбцов
+     */
+    TEST(MaxKey) {
+        CHECK_THROW(Table cipher(101), cipher_error);
+        CHECK_THROW(Table cipher(200, 150), cipher_error);
+        Table cipher(1000000, 1 << 30);
+        CHECK_WIDE_EQUAL(L"РИМТЕВИРП", cipher.encrypt(L"ПРИВЕТМИР"));
+        CHECK_WIDE_EQUAL(L"ПРИВЕТМИР", cipher.decrypt(L"РИМТЕВИРП"));
+        cipher.setCols(1 << 30);
+        CHECK_THROW(cipher.setCols((1 << 30) + 1), cipher_error);
+        CHECK_WIDE_EQUAL(L"РИМТЕВИРП", cipher.encrypt(L"ПРИВЕТМИР"));
+    }
 }
 
 /**
@@ -187,6 +221,13 @@ SUITE(EncryptTest)
     TEST_FIXTURE(Key3Fixture, StringWithPunctuation) {
         CHECK_WIDE_EQUAL(L"ИТРРЕИПВМ", cipher->encrypt(L"ПРИВЕТ, МИР"));
     }
+
+    /**
+     * @brief Тест шифрования строки с буквой "ё"
+     */
+    TEST_FIXTURE(Key3Fixture, YoLetter) {
+        CHECK_WIDE_EQUAL(L"ЖЁЕ", cipher->encrypt(L"ЕёЖ"));
+    }
     
     /**
      * @brief Тест шифрования с ключом не кратным длине текста
@@ -289,6 +330,881 @@ SUITE(DecryptTest)
     }
 }
 
+/**
+ * @brief Эталонное шифрование через таблицу с заполнителем
+ * @param [in] text Текст из прописных букв
+ * @param [in] cols Количество столбцов
+ * @return Текст, прочитанный по столбцам справа налево
+ */
+wstring gridEncrypt(const wstring& text, int cols) {
+    int n = static_cast<int>(text.size());
+    int rows = (n + cols - 1) / cols;
+    vector<vector<wchar_t>> table(rows, vector<wchar_t>(cols, L' '));
+    for (int i = 0; i < n; i++)
+        table[i / cols][i % cols] = text[i];
+    wstring result;
+    for (int col = cols - 1; col >= 0; col--)
+        for (int row = 0; row < rows; row++)
+            if (table[row][col] != L' ')
+                result += table[row][col];
+    return result;
+}
+
+/**
+ * @brief Test Suite для сравнения с эталонной таблицей
+ */
+SUITE(ReferenceTest)
+{
+    /**
+     * @brief Тест совпадения с эталоном для разных длин и ключей
+     */
+    TEST(MatchesGrid) {
+        const wstring alpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+        wstring text;
+        for (int n = 1; n <= 70; n++) {
+            text += alpha[(n * 7) % 33];
+            for (int cols = 1; cols <= 12; cols++) {
+                Table cipher(cols);
+                wstring expected = gridEncrypt(text, cols);
+                CHECK_WIDE_EQUAL(expected, cipher.encrypt(text));
+                CHECK_WIDE_EQUAL(text, cipher.decrypt(expected));
+            }
+        }
+    }
+
+    /**
+     * @brief Тест блочного обхода на длинных текстах
+     * @details Длины выше порога блочного обхода, ключи кратные и не кратные 8
+     */
+    TEST(BlockedMatchesPlan) {
+        const wstring alpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+        for (size_t n : {transposeThreshold, transposeThreshold + 77}) {
+            wstring text(n, L'А');
+            for (size_t i = 0; i < n; i++)
+                text[i] = alpha[(i * 7 + i / 33) % 33];
+            for (int cols : {2, 8, 13, 64, 100}) {
+                Table cipher(cols);
+                TablePlan plan(cols, n);
+                wstring expected(n, L'\0');
+                plan.encrypt(text.data(), &expected[0]);
+                wstring encrypted = cipher.encrypt(text);
+                CHECK(expected == encrypted);
+                CHECK(text == cipher.decrypt(encrypted));
+                string utf8 = wideToUtf8(text);
+                CHECK(wideToUtf8(expected) == cipher.encrypt(string_view(utf8)));
+            }
+        }
+    }
+    
+    /**
+     * @brief Тест количества столбцов больше 100 и больше длины текста
+     * @details При cols >= n перестановка совпадает с cols = n, то есть
+     * с переворотом текста; ключи меньше n сравниваются с планом
+     */
+    TEST(HugeKey) {
+        const wstring alpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+        size_t n = 2 * transposeThreshold + 5;
+        wstring text(n, L'А');
+        for (size_t i = 0; i < n; i++)
+            text[i] = alpha[(i * 7 + i / 33) % 33];
+        wstring reversed(text.rbegin(), text.rend());
+        string utf8 = wideToUtf8(text);
+        for (int cols : {1000, 50000, static_cast<int>(n), static_cast<int>(n) + 7, 1 << 30}) {
+            Table cipher(cols, 1 << 30);
+            wstring expected(n, L'\0');
+            TablePlan(cols, n).encrypt(text.data(), &expected[0]);
+            if (static_cast<size_t>(cols) >= n)
+                CHECK(reversed == expected);
+            wstring encrypted = cipher.encrypt(text);
+            CHECK(expected == encrypted);
+            CHECK(text == cipher.decrypt(encrypted));
+            CHECK(encrypted == cipher.encryptParallel(text, 4));
+            CHECK(text == cipher.decryptParallel(encrypted, 4));
+            CHECK(wideToUtf8(expected) == cipher.encrypt(string_view(utf8)));
+            CHECK(cipher.encrypt(IndexedText::fromOpenText(text)).toWide() == expected);
+            CHECK(MultiTable({cols, 3}, 1 << 30).encrypt(text) == Table(3).encrypt(encrypted));
+        }
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования планов перестановки
+ */
+SUITE(PlanTest)
+{
+    /**
+     * @brief Тест индексов плана
+     */
+    TEST(Indices) {
+        TablePlan plan(3, 7);
+        vector<uint32_t> expected = {2, 5, 1, 4, 0, 3, 6};
+        CHECK(expected == plan.indices());
+    }
+
+    /**
+     * @brief Тест повторного использования плана из кэша
+     */
+    TEST_FIXTURE(Key3Fixture, CacheReuse) {
+        auto first = cipher->plan(9);
+        CHECK(first == cipher->plan(9));
+        CHECK(first != cipher->plan(10));
+    }
+
+    /**
+     * @brief Тест вытеснения плана из ограниченного кэша
+     */
+    TEST_FIXTURE(Key3Fixture, CacheBound) {
+        auto first = cipher->plan(1);
+        for (size_t n = 2; n <= Table::planCacheSize + 1; n++)
+            cipher->plan(n);
+        CHECK(first != cipher->plan(1));
+    }
+
+    /**
+     * @brief Тест ограничения кэша по суммарному размеру планов
+     * @details План больше planCacheBytes не кэшируется, а два плана
+     * больше половины предела не помещаются вместе
+     */
+    TEST_FIXTURE(Key3Fixture, CacheBytes) {
+        size_t limit = Table::planCacheBytes / sizeof(uint32_t);
+        auto huge = cipher->plan(limit + 1);
+        CHECK(huge != cipher->plan(limit + 1));
+        auto half = cipher->plan(limit / 2 + 1);
+        CHECK(half == cipher->plan(limit / 2 + 1));
+        auto other = cipher->plan(limit / 2 + 2);
+        CHECK(other == cipher->plan(limit / 2 + 2));
+        CHECK(half != cipher->plan(limit / 2 + 1));
+    }
+    
+    /**
+     * @brief Тест отказа от плана для текста длиннее UINT32_MAX
+     * @details План не строится даже при неограниченном кэше
+     */
+    TEST(RepeatedTooLong) {
+        TablePlanCache cache(8, SIZE_MAX);
+        const size_t n = size_t(UINT32_MAX) + 1;
+        const vector<int> keys = {3, 5};
+        CHECK(cache.getRepeated(keys, n) == nullptr);
+        CHECK(cache.getRepeated(keys, n) == nullptr);
+    }
+
+    /**
+     * @brief Тест пакетного шифрования
+     */
+    TEST_FIXTURE(Key3Fixture, Batch) {
+        vector<wstring> plains = {L"ПРИВЕТМИР", L"привет, мир", L"АБВГД", L"ДОБРЫЙ ВЕЧЕР"};
+        vector<wstring> encrypted = cipher->encryptBatch(plains);
+        CHECK_EQUAL(plains.size(), encrypted.size());
+        for (size_t i = 0; i < plains.size(); i++)
+            CHECK_WIDE_EQUAL(cipher->encrypt(plains[i]), encrypted[i]);
+        vector<wstring> decrypted = cipher->decryptBatch(encrypted);
+        CHECK_WIDE_EQUAL(L"ПРИВЕТМИР", decrypted[1]);
+        CHECK_WIDE_EQUAL(L"ДОБРЫЙВЕЧЕР", decrypted[3]);
+    }
+
+    /**
+     * @brief Тест пакетного шифрования с невалидным сообщением
+     */
+    TEST_FIXTURE(Key3Fixture, BatchInvalid) {
+        CHECK_THROW(cipher->encryptBatch({L"ПРИВЕТ", L"123"}), cipher_error);
+    }
+
+    /**
+     * @brief Тест пакетного шифрования в общий буфер
+     */
+    TEST_FIXTURE(Key3Fixture, ArenaBatch) {
+        vector<wstring_view> plains = {L"ПРИВЕТМИР", L"привет, мир", L"А", L"ДОБРЫЙ ВЕЧЕР"};
+        CipherBatch encrypted;
+        cipher->encryptBatch(plains.data(), plains.size(), encrypted);
+        CHECK_EQUAL(plains.size(), encrypted.size());
+        for (size_t i = 0; i < plains.size(); i++) {
+            CHECK(encrypted.status[i] == cipher_status::ok);
+            CHECK_WIDE_EQUAL(cipher->encrypt(wstring(plains[i])), wstring(encrypted.result(i)));
+        }
+        vector<wstring_view> ciphers;
+        for (size_t i = 0; i < encrypted.size(); i++)
+            ciphers.push_back(encrypted.result(i));
+        CipherBatch decrypted;
+        cipher->decryptBatch(ciphers.data(), ciphers.size(), decrypted);
+        CHECK_WIDE_EQUAL(L"ПРИВЕТМИР", wstring(decrypted.result(1)));
+        CHECK_WIDE_EQUAL(L"ДОБРЫЙВЕЧЕР", wstring(decrypted.result(3)));
+    }
+
+    /**
+     * @brief Тест состояния каждого сообщения пакета
+     */
+    TEST_FIXTURE(Key3Fixture, ArenaBatchStatus) {
+        vector<wstring_view> plains = {L"ПРИВЕТ", L"123", L"МИР"};
+        CipherBatch out;
+        cipher->encryptBatch(plains.data(), plains.size(), out);
+        CHECK(out.status[1] == cipher_status::empty_text);
+        CHECK(out.result(1).empty());
+        CHECK_WIDE_EQUAL(cipher->encrypt(L"МИР"), wstring(out.result(2)));
+        vector<wstring_view> ciphers = {L"ИТР", L"", L"ИТр", L"РИМ"};
+        cipher->decryptBatch(ciphers.data(), ciphers.size(), out);
+        CHECK_EQUAL(4u, out.size());
+        CHECK(out.status[0] == cipher_status::ok);
+        CHECK(out.status[1] == cipher_status::empty_text);
+        CHECK(out.status[2] == cipher_status::invalid_text);
+        CHECK_WIDE_EQUAL(cipher->decrypt(L"РИМ"), wstring(out.result(3)));
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования параллельного режима
+ */
+SUITE(ParallelTest)
+{
+    /**
+     * @brief Тест совпадения с последовательным шифрованием
+     */
+    TEST(MatchesSerial) {
+        const wstring alpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+        size_t n = 3 * transposeThreshold + 5;
+        wstring text(n, L'А');
+        for (size_t i = 0; i < n; i++)
+            text[i] = alpha[(i * 11 + i / 40) % 33];
+        for (int cols : {3, 16, 37}) {
+            Table cipher(cols);
+            wstring expected = cipher.encrypt(text);
+            for (unsigned threads : {2u, 3u, 8u}) {
+                wstring encrypted = cipher.encryptParallel(text, threads);
+                CHECK(expected == encrypted);
+                CHECK(text == cipher.decryptParallel(encrypted, threads));
+            }
+        }
+    }
+
+    /**
+     * @brief Тест короткого текста в параллельном режиме
+     */
+    TEST_FIXTURE(Key3Fixture, ShortText) {
+        CHECK_WIDE_EQUAL(L"ИТРРЕИПВМ", cipher->encryptParallel(L"ПРИВЕТ МИР", 4));
+        CHECK_WIDE_EQUAL(L"ПРИВЕТМИР", cipher->decryptParallel(L"ИТРРЕИПВМ", 4));
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования многораундовой перестановки
+ */
+SUITE(MultiTableTest)
+{
+    /**
+     * @brief Тест совпадения с последовательными раундами
+     */
+    TEST(MatchesSequential) {
+        wstring text = L"ДОБРЫЙВЕЧЕРПРИВЕТМИРАБВГДЕЁЖЗ";
+        for (size_t len = 1; len <= text.size(); len++) {
+            wstring part = text.substr(0, len);
+            MultiTable multi({3, 5, 4});
+            wstring expected = Table(4).encrypt(Table(5).encrypt(Table(3).encrypt(part)));
+            wstring encrypted = multi.encrypt(part);
+            CHECK_WIDE_EQUAL(expected, encrypted);
+            CHECK_WIDE_EQUAL(part, multi.decrypt(encrypted));
+        }
+    }
+
+    /**
+     * @brief Тест одного раунда
+     */
+    TEST(SingleRound) {
+        CHECK_WIDE_EQUAL(L"ИТРРЕИПВМ", MultiTable({3}).encrypt(L"привет мир"));
+    }
+
+    /**
+     * @brief Тест повторяющихся и меняющихся длин
+     * @details Первые вызовы с новой длиной идут без плана, повторные - по
+     * плану из кэша; длинный текст проходит блочными раундами
+     */
+    TEST(RepeatedLengths) {
+        const MultiTable multi({7, 13, 5});
+        for (size_t n : {size_t(1000), size_t(1001), size_t(1000), transposeThreshold + 77, size_t(1000)}) {
+            wstring text(n, L'А');
+            for (size_t i = 0; i < n; i++)
+                text[i] = static_cast<wchar_t>(L'А' + (i * 11 + i / 32) % 32);
+            wstring expected = Table(5).encrypt(Table(13).encrypt(Table(7).encrypt(text)));
+            for (int k = 0; k < 3; k++) {
+                CHECK(expected == multi.encrypt(text));
+                CHECK(text == multi.decrypt(expected));
+            }
+        }
+    }
+
+    /**
+     * @brief Тест невалидных ключей
+     */
+    TEST(InvalidKeys) {
+        CHECK_THROW(MultiTable({}), cipher_error);
+        CHECK_THROW(MultiTable({3, 0}), cipher_error);
+    }
+
+    /**
+     * @brief Тест невалидного шифротекста
+     */
+    TEST(InvalidCipherText) {
+        MultiTable multi({3, 4});
+        CHECK_THROW(multi.decrypt(L"ИТР РЕИ"), cipher_error);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования работы с UTF-8
+ */
+SUITE(Utf8Test)
+{
+    /**
+     * @brief Тест шифрования текста в UTF-8
+     */
+    TEST_FIXTURE(Key3Fixture, Encrypt) {
+        CHECK_EQUAL(string("ИТРРЕИПВМ"), cipher->encrypt(string_view("Привет, мир!")));
+    }
+
+    /**
+     * @brief Тест дешифрования текста в UTF-8
+     */
+    TEST_FIXTURE(Key3Fixture, Decrypt) {
+        CHECK_EQUAL(string("ПРИВЕТМИР"), cipher->decrypt(string_view("ИТРРЕИПВМ")));
+    }
+
+    /**
+     * @brief Тест совпадения с шифрованием через wstring
+     */
+    TEST(MatchesWide) {
+        Table cipher(4);
+        string text = "Добрый вечер, ёжик — ça va €";
+        CHECK_EQUAL(wideToUtf8(cipher.encrypt(utf8ToWide(text))), cipher.encrypt(string_view(text)));
+    }
+
+    /**
+     * @brief Тест дешифрования невалидного текста в UTF-8
+     */
+    TEST_FIXTURE(Key3Fixture, InvalidCipherText) {
+        CHECK_THROW(cipher->decrypt(string_view("ИТРр")), cipher_error);
+        CHECK_THROW(cipher->decrypt(string_view("ИТР 1")), cipher_error);
+    }
+
+    /**
+     * @brief Тест оборванных последовательностей UTF-8
+     * @details Ведущий байт без байтов продолжения не поглощает следующую букву
+     */
+    TEST(MalformedSequence) {
+        Table cipher(2);
+        CHECK_EQUAL(wideToUtf8(cipher.encrypt(wstring(L"абв"))),
+                    cipher.encrypt(string_view("\xE2\xD0\x90\xF0\x9F\xD0\x91\xD0\x92")));
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования перестановки с фиксированным количеством столбцов
+ */
+SUITE(FixedTest)
+{
+    /**
+     * @brief Проверка совпадения TableFixed<Cols> с Table(Cols) на разных длинах
+     */
+    template <int Cols>
+    void checkMatches(const wstring& text) {
+        Table runtime(Cols, std::max(Cols, Table::defaultMaxKey));
+        TableFixed<Cols> fixed;
+        for (size_t len : {size_t(1), size_t(Cols), size_t(Cols + 1), size_t(97), text.size()}) {
+            wstring part = text.substr(0, len);
+            wstring encrypted = fixed.encrypt(part);
+            CHECK(runtime.encrypt(part) == encrypted);
+            CHECK(runtime.decrypt(encrypted) == fixed.decrypt(encrypted));
+        }
+    }
+
+    /**
+     * @brief Тест совпадения с Table для нескольких количеств столбцов
+     */
+    TEST(MatchesRuntime) {
+        const wstring alpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+        size_t n = transposeThreshold + 7;
+        wstring text(n, L'А');
+        for (size_t i = 0; i < n; i++)
+            text[i] = alpha[(i * 7 + i / 33) % 33];
+        checkMatches<1>(text);
+        checkMatches<3>(text);
+        checkMatches<8>(text);
+        checkMatches<37>(text);
+        checkMatches<100>(text);
+        checkMatches<200>(text);
+        checkMatches<1000>(text);
+    }
+
+    /**
+     * @brief Тест нормализации и исключений
+     */
+    TEST(SameValidation) {
+        TableFixed<3> fixed;
+        CHECK_WIDE_EQUAL(L"ИТРРЕИПВМ", fixed.encrypt(L"привет, мир!"));
+        CHECK_THROW(fixed.encrypt(L"123 !"), cipher_error);
+        CHECK_THROW(fixed.decrypt(L""), cipher_error);
+        CHECK_THROW(fixed.decrypt(L"ИТР РЕИ"), cipher_error);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования выделения памяти из заданного источника
+ */
+SUITE(PmrTest)
+{
+    /**
+     * @brief Тест шифрования без обращения к общей куче
+     * @details Длинный текст проверяет и разметку блочного обхода
+     */
+    TEST(ArenaOnly) {
+        const wstring alpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+        wstring text(transposeThreshold + 3, L'А');
+        for (size_t i = 0; i < text.size(); i++)
+            text[i] = alpha[i % 33];
+        Table cipher(7);
+        static char buffer[1 << 20];
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        std::pmr::wstring encrypted = cipher.encrypt(text, &arena);
+        CHECK(cipher.encrypt(text) == wstring(encrypted));
+        CHECK(text == wstring(cipher.decrypt(encrypted, &arena)));
+        CHECK_WIDE_EQUAL(L"ИТРРЕИПВМ", wstring(Table(3).encrypt(L"привет, мир", &arena)));
+    }
+
+    /**
+     * @brief Тест исключений при заданном источнике памяти
+     */
+    TEST(InvalidText) {
+        Table cipher(3);
+        std::pmr::monotonic_buffer_resource arena;
+        CHECK_THROW(cipher.encrypt(L"123", &arena), cipher_error);
+        CHECK_THROW(cipher.decrypt(L"", &arena), cipher_error);
+        CHECK_THROW(cipher.decrypt(L"ИТр", &arena), cipher_error);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования API без исключений
+ */
+SUITE(TryTest)
+{
+    /**
+     * @brief Тест совпадения с методами, возбуждающими исключения
+     */
+    TEST_FIXTURE(Key3Fixture, MatchesThrowing) {
+        wstring out;
+        CHECK(cipher->tryEncrypt(L"привет, мир", out));
+        CHECK_WIDE_EQUAL(L"ИТРРЕИПВМ", out);
+        wstring plain;
+        CHECK(cipher->tryDecrypt(out, plain));
+        CHECK_WIDE_EQUAL(L"ПРИВЕТМИР", plain);
+    }
+
+    /**
+     * @brief Тест кода ошибки и позиции недопустимого символа
+     */
+    TEST_FIXTURE(Key3Fixture, InvalidPosition) {
+        wstring out;
+        cipher_result r = cipher->tryDecrypt(L"ИТР РЕИ", out);
+        CHECK(r.status == cipher_status::invalid_text);
+        CHECK_EQUAL(3u, r.position);
+        CHECK(cipher->tryDecrypt(L"", out).status == cipher_status::empty_text);
+        CHECK(cipher->tryEncrypt(L"123", out).status == cipher_status::empty_text);
+        CHECK(out.empty());
+    }
+
+    /**
+     * @brief Тест проверки ключа без исключений
+     */
+    TEST(CheckKey) {
+        CHECK(Table::checkKey(1));
+        CHECK(Table::checkKey(100));
+        CHECK(Table::checkKey(0).status == cipher_status::invalid_key);
+        CHECK(Table::checkKey(-3).status == cipher_status::invalid_key);
+        CHECK(Table::checkKey(101).status == cipher_status::invalid_key);
+        CHECK(Table::checkKey(101, 1000));
+        CHECK(Table::checkKey(1001, 1000).status == cipher_status::invalid_key);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования счетчиков
+ */
+SUITE(StatsTest)
+{
+    /**
+     * @brief Тест счетчиков шифрования и отказов
+     * @details Без CIPHER_STATS счетчики не изменяются
+     */
+    TEST_FIXTURE(Key3Fixture, Counters) {
+        CipherStatsSnapshot before = Table::stats().snapshot();
+        wstring encrypted = cipher->encrypt(L"привет, мир");
+        std::string utf8 = cipher->encrypt(std::string("привет, мир"));
+        CHECK_THROW(cipher->decrypt(L"ИТР РЕИ"), cipher_error);
+        CHECK_THROW(Table(0), cipher_error);
+        CipherStatsSnapshot after = Table::stats().snapshot();
+#if defined(CIPHER_STATS)
+        CHECK_EQUAL(11u + 20u, after.charsIn - before.charsIn);
+        CHECK_EQUAL(18u, after.lettersKept - before.lettersKept);
+        CHECK_EQUAL(2u + 11u, after.lettersDropped - before.lettersDropped);
+        CHECK_EQUAL(encrypted.size() + utf8.size(), after.charsOut - before.charsOut);
+        size_t text = static_cast<size_t>(cipher_status::invalid_text);
+        size_t key = static_cast<size_t>(cipher_status::invalid_key);
+        CHECK_EQUAL(1u, after.rejected[text] - before.rejected[text]);
+        CHECK_EQUAL(1u, after.rejected[key] - before.rejected[key]);
+#else
+        CHECK_EQUAL(before.charsIn, after.charsIn);
+        CHECK_EQUAL(0u, after.charsOut);
+#endif
+    }
+    
+    /**
+     * @brief Тест счетчиков методов без исключений
+     */
+    TEST_FIXTURE(Key3Fixture, TryCounters) {
+        CipherStatsSnapshot before = Table::stats().snapshot();
+        wstring encrypted, decrypted, bad;
+        CHECK(cipher->tryEncrypt(L"привет, мир", encrypted).status == cipher_status::ok);
+        CHECK(cipher->tryDecrypt(encrypted, decrypted).status == cipher_status::ok);
+        CHECK(cipher->tryEncrypt(L"123", bad).status == cipher_status::empty_text);
+        CHECK(cipher->tryDecrypt(L"", bad).status == cipher_status::empty_text);
+        CHECK(cipher->tryDecrypt(L"ИТР РЕИ", bad).status == cipher_status::invalid_text);
+        CipherStatsSnapshot after = Table::stats().snapshot();
+#if defined(CIPHER_STATS)
+        CHECK_EQUAL(11u + 9u + 3u, after.charsIn - before.charsIn);
+        CHECK_EQUAL(9u + 9u, after.lettersKept - before.lettersKept);
+        CHECK_EQUAL(2u + 3u, after.lettersDropped - before.lettersDropped);
+        CHECK_EQUAL(encrypted.size() + decrypted.size(), after.charsOut - before.charsOut);
+        size_t empty = static_cast<size_t>(cipher_status::empty_text);
+        size_t text = static_cast<size_t>(cipher_status::invalid_text);
+        CHECK_EQUAL(2u, after.rejected[empty] - before.rejected[empty]);
+        CHECK_EQUAL(1u, after.rejected[text] - before.rejected[text]);
+#else
+        CHECK_EQUAL(before.charsIn, after.charsIn);
+        CHECK_EQUAL(0u, after.charsOut);
+#endif
+    }
+    
+    /**
+     * @brief Тест счетчиков параллельных методов
+     */
+    TEST(ParallelCounters) {
+        Table cipher(7);
+        wstring text(3 * transposeThreshold, L'ж');
+        CipherStatsSnapshot before = Table::stats().snapshot();
+        wstring encrypted = cipher.encryptParallel(text, 4);
+        wstring decrypted = cipher.decryptParallel(encrypted, 4);
+        CipherStatsSnapshot after = Table::stats().snapshot();
+        CHECK(cipher.decrypt(encrypted) == decrypted);
+#if defined(CIPHER_STATS)
+        CHECK_EQUAL(2 * text.size(), after.charsIn - before.charsIn);
+        CHECK_EQUAL(encrypted.size() + decrypted.size(), after.charsOut - before.charsOut);
+        size_t transform = static_cast<size_t>(cipher_stage::transform);
+        CHECK(after.stageNanos[transform] > before.stageNanos[transform]);
+#else
+        CHECK_EQUAL(before.charsOut, after.charsOut);
+#endif
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования однобайтового представления текста
+ */
+SUITE(IndexedTest)
+{
+    /**
+     * @brief Тест совпадения с шифрованием wstring
+     * @details Короткий текст и текст длиннее порога блочного обхода
+     */
+    TEST(MatchesWide) {
+        wstring longText(2 * transposeThreshold + 5, L'а');
+        for (size_t i = 0; i < longText.size(); i += 7)
+            longText[i] = L'я';
+        for (const wstring& text : {wstring(L"привет, мир"), longText}) {
+            for (int cols : {1, 3, 37}) {
+                Table cipher(cols);
+                IndexedText encrypted = cipher.encrypt(IndexedText::fromOpenText(text));
+                CHECK(cipher.encrypt(text) == encrypted.toWide());
+                CHECK(cipher.decrypt(encrypted) == IndexedText::fromOpenText(text));
+            }
+        }
+    }
+
+    /**
+     * @brief Тест пустого текста
+     */
+    TEST_FIXTURE(Key3Fixture, EmptyText) {
+        CHECK_THROW(cipher->encrypt(IndexedText::fromOpenText(L"123")), cipher_error);
+        CHECK_THROW(cipher->decrypt(IndexedText()), cipher_error);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования блочного формата
+ */
+SUITE(FramedTest)
+{
+    /**
+     * @brief Русский текст в UTF-8 заданной длины в буквах
+     * @param [in] letters Количество букв
+     * @return Текст с пробелами и знаками препинания
+     */
+    std::string framedText(size_t letters)
+    {
+        const std::string words[] = {"привет", ", ", "мир", " ", "Ёж", "! 1", "съешь"};
+        std::string s;
+        for (size_t i = 0, n = 0; n < letters; ++i) {
+            const std::string& w = words[i % 7];
+            s += w;
+            n += IndexedText::fromUtf8(w).size();
+        }
+        return s;
+    }
+
+    /**
+     * @brief Тест шифрования и дешифрования в несколько потоков
+     * @details Каждый кадр совпадает с Table::encrypt() для букв блока
+     */
+    TEST(RoundTrip) {
+        std::string text = framedText(1000);
+        std::string letters = IndexedText::fromUtf8(text).toUtf8();
+        for (int cols : {1, 3, 7}) {
+            TableFramed format(cols, 21 * cols);
+            std::string framed = format.encrypt(text, 4);
+            CHECK(format.encrypt(text) == framed);
+            CHECK_EQUAL(letters, format.decrypt(framed, 3));
+            size_t blocks = (letters.size() / 2 + format.blockSize() - 1) / format.blockSize();
+            for (size_t k = 0; k < blocks; ++k) {
+                std::string plain = letters.substr(2 * k * format.blockSize(), 2 * format.blockSize());
+                size_t offset = format.frameOffset(k) + TableFramed::frameHeaderSize;
+                CHECK_EQUAL(Table(cols).encrypt(std::string_view(plain)), framed.substr(offset, plain.size()));
+                CHECK_EQUAL(plain, format.decryptBlock(framed, k));
+            }
+            CHECK_THROW(format.decryptBlock(framed, blocks), cipher_error);
+        }
+    }
+
+    /**
+     * @brief Тест потоковой обработки произвольными фрагментами
+     * @details Фрагменты обрывают символы UTF-8 и заголовки кадров
+     */
+    TEST(Stream) {
+        std::string text = framedText(500);
+        TableFramed format(5, 40);
+        std::string framed = format.encrypt(text);
+        for (size_t step : {1, 3, 7, 1000}) {
+            TableFrameStream enc(format, TableFrameStream::Mode::Encrypt);
+            std::string out;
+            for (size_t pos = 0; pos < text.size(); pos += step)
+                out += enc.update(std::string_view(text).substr(pos, step));
+            out += enc.finish();
+            CHECK(framed == out);
+            TableFrameStream dec(TableFramed::fromHeader(framed), TableFrameStream::Mode::Decrypt);
+            std::string plain;
+            for (size_t pos = 0; pos < framed.size(); pos += step)
+                plain += dec.update(std::string_view(framed).substr(pos, step));
+            plain += dec.finish();
+            CHECK_EQUAL(format.decrypt(framed), plain);
+        }
+    }
+
+    /**
+     * @brief Тест невалидных параметров и текста
+     */
+    TEST(Invalid) {
+        CHECK_THROW(TableFramed(3, 10), cipher_error);
+        CHECK_THROW(TableFramed(3, 0), cipher_error);
+        CHECK_THROW(TableFramed(0, 10), cipher_error);
+        TableFramed format(3, 9);
+        CHECK_THROW(format.encrypt("123"), cipher_error);
+        std::string framed = format.encrypt(framedText(20));
+        CHECK_THROW(format.decrypt(framed.substr(0, framed.size() - 1)), cipher_error);
+        CHECK_THROW(TableFramed(3, 12).decrypt(framed), cipher_error);
+        CHECK_THROW(format.decrypt(format.header()), cipher_error);
+        std::string lower = framed;
+        lower[TableFramed::headerSize + TableFramed::frameHeaderSize + 1] ^= 0x20;
+        CHECK_THROW(format.decrypt(lower), cipher_error);
+        TableFrameStream dec(format, TableFrameStream::Mode::Decrypt);
+        dec.update(framed.substr(0, framed.size() - 2));
+        CHECK_THROW(dec.finish(), cipher_error);
+        CHECK_THROW(TableFramed::fromHeader("TBF0"), cipher_error);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования дешифрования участка
+ */
+SUITE(RangeTest)
+{
+    /**
+     * @brief Тест совпадения с участком полного дешифрования
+     * @details Короткий и длинный тексты, ключи при неполной последней
+     * строке и больше длины текста
+     */
+    TEST(MatchesDecrypt) {
+        const wstring alpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+        for (size_t n : {size_t(9), size_t(70), transposeThreshold + 77}) {
+            wstring text(n, L'А');
+            for (size_t i = 0; i < n; i++)
+                text[i] = alpha[(i * 7 + i / 33) % 33];
+            for (int cols : {1, 3, 8, 13, 100, 100000}) {
+                Table cipher(cols, 1 << 20);
+                wstring encrypted = cipher.encrypt(text);
+                string utf8 = wideToUtf8(encrypted);
+                for (size_t pos : {size_t(0), size_t(1), n / 3, n - 1}) {
+                    for (size_t len : {size_t(0), size_t(1), size_t(5), n - pos}) {
+                        if (pos + len > n)
+                            continue;
+                        CHECK(text.substr(pos, len) == cipher.decryptRange(encrypted, pos, len));
+                        CHECK(wideToUtf8(text.substr(pos, len)) == cipher.decryptRange(string_view(utf8), pos, len));
+                    }
+                }
+            }
+        }
+    }
+    
+    /**
+     * @brief Тест границ и проверки только прочитанных букв
+     */
+    TEST_FIXTURE(Key3Fixture, Invalid) {
+        wstring encrypted = cipher->encrypt(L"ПРИВЕТМИР");
+        CHECK_THROW(cipher->decryptRange(encrypted, 5, 5), cipher_error);
+        CHECK_THROW(cipher->decryptRange(encrypted, 1, static_cast<size_t>(-1)), cipher_error);
+        CHECK_THROW(cipher->decryptRange(string_view("\xd0\x9f\xd0"), 0, 1), cipher_error);
+        // Третий столбец читается первым: шифротекст начинается с буквы 2
+        encrypted[0] = L'и';
+        CHECK_THROW(cipher->decryptRange(encrypted, 2, 1), cipher_error);
+        CHECK_WIDE_EQUAL(L"ПР", cipher->decryptRange(encrypted, 0, 2));
+        CHECK_WIDE_EQUAL(L"ВЕТМИ", cipher->decryptRange(encrypted, 3, 5));
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования векторной нормализации
+ */
+SUITE(NormalizeTest)
+{
+    /**
+     * @brief Все реализации ядер, доступные на этом процессоре
+     * @return Скалярная реализация и выбранная по процессору
+     */
+    std::vector<normalize_detail::NormalizeImpl> impls() {
+        std::vector<normalize_detail::NormalizeImpl> all{normalize_detail::normalizeImpl()};
+        all.push_back({normalize_detail::indicesScalar, normalize_detail::lettersScalar,
+                       normalize_detail::upperScalar, Alphabet::findNonUpper, "scalar"});
+#if defined(NORMALIZE_X86)
+        if (__builtin_cpu_supports("avx2"))
+            all.push_back({normalize_detail::indicesAvx2, normalize_detail::lettersAvx2,
+                           normalize_detail::upperAvx2, normalize_detail::findAvx2, "avx2"});
+#endif
+        return all;
+    }
+    
+    /**
+     * @brief Тест совпадения с посимвольными функциями Alphabet
+     * @details Все символы U+0000..U+04FF и соседние с кириллицей коды
+     * вплоть до переполнения при вычитании, со всеми длинами хвоста
+     */
+    TEST(MatchesAlphabet) {
+        wstring text;
+        for (wchar_t c = 0; c < 0x500; c++)
+            text += c;
+        for (wchar_t c : {wchar_t(0x10410), wchar_t(0x20401), wchar_t(0x7FFFFFFF), wchar_t(0x400), wchar_t(0x460)})
+            text += c;
+        for (const auto& impl : impls()) {
+            for (size_t start : {size_t(0), size_t(0x3F7), size_t(0x401), size_t(0x40F)}) {
+                for (size_t n = 0; start + n <= text.size() && n <= 100; n++) {
+                    const wchar_t* s = text.data() + start;
+                    vector<uint8_t> expectIdx, idx(n);
+                    wstring expectLetters, letters(n, L'\0');
+                    for (size_t i = 0; i < n; i++) {
+                        if (Alphabet::index(s[i]) >= 0) {
+                            expectIdx.push_back(static_cast<uint8_t>(Alphabet::index(s[i])));
+                            expectLetters += Alphabet::toUpper(s[i]);
+                        }
+                    }
+                    idx.resize(impl.indices(s, n, idx.data()));
+                    letters.resize(impl.letters(s, n, &letters[0]));
+                    CHECK(expectIdx == idx);
+                    CHECK(expectLetters == letters);
+                    vector<uint8_t> upper(n);
+                    size_t bad = impl.upper(s, n, upper.data());
+                    CHECK_EQUAL(Alphabet::findNonUpper(s, n), bad);
+                    CHECK_EQUAL(bad, impl.find(s, n));
+                }
+            }
+            wstring upperText = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯЯЮЭЬЫЪЩШЧЦХФУТСРПОНМЛКЙИЗЖЁЕДГВБА";
+            vector<uint8_t> upper(upperText.size());
+            CHECK_EQUAL(upperText.size(), impl.upper(upperText.data(), upperText.size(), upper.data()));
+            CHECK_EQUAL(upperText.size(), impl.find(upperText.data(), upperText.size()));
+            for (size_t i = 0; i < upperText.size(); i++)
+                CHECK_EQUAL(Alphabet::upperIndex(upperText[i]), upper[i]);
+            upperText[40] = L'ё';
+            CHECK_EQUAL(40u, impl.find(upperText.data(), upperText.size()));
+            CHECK_EQUAL(40u, impl.upper(upperText.data(), upperText.size(), upper.data()));
+        }
+    }
+    
+    /**
+     * @brief Тест уплотнения на месте
+     */
+    TEST(InPlace) {
+        wstring text = L"Съешь же ещё этих мягких французских булок, да выпей чаю";
+        wstring expected = Table(1).encrypt(text);
+        text.resize(Normalize::letters(text.data(), text.size(), &text[0]));
+        CHECK_WIDE_EQUAL(expected, text);
+    }
+}
+
+/**
+ * @brief Test Suite для тестирования одновременного использования
+ */
+SUITE(ConcurrencyTest)
+{
+    /**
+     * @brief Тест общего объекта в нескольких потоках
+     * @details Потоки одновременно шифруют и дешифруют одним объектом,
+     * в том числе пакетами разных длин, которые вытесняют друг друга из
+     * кэша планов; результаты сравниваются с вычисленными заранее
+     */
+    TEST(SharedInstance) {
+        const Table shared(7);
+        const MultiTable rounds({7, 3, 11});
+        std::vector<wstring> texts;
+        for (size_t k = 0; k < 2 * Table::planCacheSize; k++) {
+            wstring text;
+            for (size_t i = 0; i < 500 + 97 * k; i++)
+                text += static_cast<wchar_t>(L'А' + (i * (k + 5)) % 32);
+            texts.push_back(text);
+        }
+        std::vector<wstring> expected, expectedRounds;
+        for (const wstring& text : texts) {
+            expected.push_back(shared.encrypt(text));
+            expectedRounds.push_back(rounds.encrypt(text));
+        }
+        std::atomic<int> mismatches{0};
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < 8; t++) {
+            threads.emplace_back([&, t] {
+                for (size_t iter = 0; iter < 40; iter++) {
+                    size_t k = (t * 3 + iter) % texts.size();
+                    const wstring& plain = texts[k];
+                    const wstring& cipher = expected[k];
+                    bool ok = shared.encrypt(plain) == cipher && shared.decrypt(cipher) == plain;
+                    string utf8 = wideToUtf8(plain);
+                    ok = ok && shared.encrypt(string_view(utf8)) == wideToUtf8(cipher);
+                    ok = ok && shared.decrypt(shared.encrypt(IndexedText::fromOpenText(plain))).toWide() == plain;
+                    ok = ok && shared.decryptRange(cipher, 10, 20) == plain.substr(10, 20);
+                    std::vector<wstring> batch = shared.encryptBatch({plain, texts[(k + 1) % texts.size()]});
+                    ok = ok && batch[0] == cipher && batch[1] == expected[(k + 1) % texts.size()];
+                    ok = ok && rounds.encrypt(plain) == expectedRounds[k] && rounds.decrypt(expectedRounds[k]) == plain;
+                    if (!ok)
+                        mismatches++;
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        CHECK_EQUAL(0, mismatches.load());
+    }
+}
+
 /**
  * @brief Главная функция запуска тестов
  * @return Код завершения тестирования
@@ -0,0 +1,236 @@
+/**
+ * @file benchCiphers.cpp
+ * @brief Набор замеров производительности обоих шифров
+ * @details Измеряет нс/символ и ГБ/с для modAlphaCipher::encrypt/decrypt и
+ * Table::encrypt/decrypt по размерам входа от 16 Б до 1 ГБ, длинам ключа
+ * 1..1000 и количеству столбцов 1..100. Отдельно измеряются проверка и
+ * нормализация текста теми же функциями, что вызывают шифры
+ * (Table::getValidOpenText, Normalize::indices, IndexedText::fromOpenText),
+ * и собственно преобразование над уже нормализованным текстом (transform). Результаты выводятся в
+ * CSV или JSON Lines для автоматического сравнения между сборками.
+ *
+ * Использование:
+ * @code
+ * benchCiphers [--max-size=БАЙТЫ] [--min-time=СЕКУНДЫ] [--format=csv|json]
+ * @endcode
+ *
+ * Сборка (обычная, с LTO и с PGO на этом же наборе замеров):
+ * @code
+ * SRC="bench/benchCiphers.cpp 2.1/modAlphaCipher.cpp 2.1/modKeySchedule.cpp 2.1/modShiftKernel.cpp \
+ *      2.2/modTableCipher.cpp 2.2/modTablePlan.cpp 2.2/modTranspose.cpp"
+ * g++ -std=c++17 -O2 -pthread $SRC -o benchCiphers
+ * g++ -std=c++17 -O3 -flto -pthread $SRC -o benchCiphers
+ * g++ -std=c++17 -O3 -flto -fprofile-generate -pthread $SRC -o benchCiphers && ./benchCiphers
+ * g++ -std=c++17 -O3 -flto -fprofile-use -pthread $SRC -o benchCiphers
+ * @endcode
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../2.1/modAlphaCipher.h"
+#include "../2.1/modShiftKernel.h"
+#include "../2.2/modTableCipher.h"
+#include "../2.2/modTranspose.h"
+
+using namespace std;
+
+/**
+ * @brief Параметры запуска
+ */
+struct Options {
+    size_t maxSize = size_t(64) << 20; ///< Наибольший размер входа в байтах
+    double minTime = 0.05;             ///< Наименьшее время одного замера в секундах
+    bool json = false;                 ///< Вывод в JSON Lines вместо CSV
+};
+
+/// Параметры текущего запуска
+Options options;
+
+/// Приемник результатов, чтобы компилятор не удалил замеряемый код
+volatile size_t sink = 0;
+
+/**
+ * @brief Вывод одной строки результата
+ * @param [in] cipher Название шифра
+ * @param [in] op Операция
+ * @param [in] bytes Размер входа в байтах
+ * @param [in] param Длина ключа или количество столбцов
+ * @param [in] chars Количество символов входа
+ * @param [in] iterations Количество повторений
+ * @param [in] seconds Суммарное время повторений
+ */
+void report(const char* cipher, const char* op, size_t bytes, size_t param,
+            size_t chars, size_t iterations, double seconds) {
+    double perIter = seconds / iterations;
+    double nsPerChar = perIter * 1e9 / chars;
+    double gbPerSec = bytes / perIter / 1e9;
+    if (options.json) {
+        printf("{\"cipher\":\"%s\",\"op\":\"%s\",\"bytes\":%zu,\"param\":%zu,"
+               "\"iterations\":%zu,\"ns_per_char\":%.4f,\"gb_per_s\":%.4f,\"kernel\":\"%s\"}\n",
+               cipher, op, bytes, param, iterations, nsPerChar, gbPerSec, shiftKernelName());
+    } else {
+        printf("%s,%s,%zu,%zu,%zu,%.4f,%.4f,%s\n",
+               cipher, op, bytes, param, iterations, nsPerChar, gbPerSec, shiftKernelName());
+    }
+    fflush(stdout);
+}
+
+/**
+ * @brief Повторение замеряемой функции не менее options.minTime секунд
+ * @param [in] f Замеряемая функция, возвращающая размер результата
+ * @param [out] iterations Количество выполненных повторений
+ * @return Суммарное время в секундах
+ */
+template <class F>
+double measure(F&& f, size_t& iterations) {
+    using clock = chrono::steady_clock;
+    iterations = 0;
+    auto start = clock::now();
+    double elapsed = 0;
+    do {
+        sink = sink + f();
+        ++iterations;
+        elapsed = chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < options.minTime);
+    return elapsed;
+}
+
+/**
+ * @brief Построение открытого текста с пробелами и знаками препинания
+ * @param [in] chars Количество символов
+ * @return Текст из строчных и прописных русских букв, пробелов и запятых
+ */
+wstring makeText(size_t chars) {
+    const wstring sample = L"Съешь же ещё этих мягких французских булок, да выпей чаю. ";
+    wstring text(chars, L' ');
+    for (size_t i = 0; i < chars; ++i)
+        text[i] = sample[i % sample.size()];
+    return text;
+}
+
+/**
+ * @brief Построение ключа Гронсфельда заданной длины
+ * @param [in] length Длина ключа
+ * @return Ключ из прописных русских букв
+ */
+wstring makeKey(size_t length) {
+    wstring key(length, L'А');
+    for (size_t i = 0; i < length; ++i)
+        key[i] = Alphabet::letter(static_cast<int>((i * 7 + 3) % Alphabet::size));
+    return key;
+}
+
+/**
+ * @brief Доступ замеров к закрытой проверке текста Table
+ */
+struct TableBench {
+    /**
+     * @brief Проверка открытого текста, как в Table::encrypt
+     * @param [in] text Исходный текст
+     * @return Только прописные русские буквы
+     * @throw cipher_error Если текст не содержит букв
+     */
+    static wstring validOpenText(const wstring& text) {
+        return Table::getValidOpenText(text);
+    }
+};
+
+/**
+ * @brief Замеры для одного размера входа
+ * @param [in] bytes Размер входа в байтах
+ */
+void runSize(size_t bytes) {
+    size_t chars = max<size_t>(1, bytes / sizeof(wchar_t));
+    wstring text = makeText(chars);
+    wstring letters = TableBench::validOpenText(text);
+    size_t it;
+
+    // Проверка и нормализация теми же функциями, что вызывают шифры
+    double t = measure([&] { return TableBench::validOpenText(text).size(); }, it);
+    report("table", "validate", bytes, 0, chars, it, t);
+    vector<uint8_t> normalized(text.size());
+    t = measure([&] { return Normalize::indices(text.data(), text.size(), normalized.data()); }, it);
+    report("common", "indices", bytes, 0, chars, it, t);
+    t = measure([&] { return IndexedText::fromOpenText(text).size(); }, it);
+    report("common", "indexed", bytes, 0, chars, it, t);
+
+    // Шифр Гронсфельда
+    vector<uint8_t> indices(letters.size());
+    for (size_t keyLen : {1u, 3u, 10u, 33u, 100u, 1000u}) {
+        wstring key = makeKey(keyLen);
+        modAlphaCipher cipher(key);
+        wstring encrypted = cipher.encrypt(text);
+        t = measure([&] { return cipher.encrypt(text).size(); }, it);
+        report("alpha", "encrypt", bytes, keyLen, chars, it, t);
+        t = measure([&] { return cipher.decrypt(encrypted).size(); }, it);
+        report("alpha", "decrypt", bytes, keyLen, letters.size(), it, t);
+
+        vector<int> keyIdx;
+        for (auto c : key)
+            keyIdx.push_back(Alphabet::index(c));
+        vector<uint8_t> stream = shiftKeyStream(keyIdx, false);
+        for (size_t i = 0; i < letters.size(); ++i)
+            indices[i] = static_cast<uint8_t>(Alphabet::index(letters[i]));
+        t = measure([&] {
+            return shiftIndices(indices.data(), indices.size(), stream.data(), keyLen, 0);
+        }, it);
+        report("alpha", "transform", bytes, keyLen, letters.size(), it, t);
+        if (keyLen * Alphabet::size <= shiftTableLimit) {
+            vector<uint8_t> table = shiftKeyTable(keyIdx, false);
+            t = measure([&] {
+                return shiftTable(indices.data(), indices.size(), table.data(), keyLen, 0);
+            }, it);
+            report("alpha", "table", bytes, keyLen, letters.size(), it, t);
+        }
+    }
+
+    // Маршрутная перестановка
+    wstring out(letters.size(), L'\0');
+    for (int cols : {1, 2, 3, 7, 10, 33, 64, 100}) {
+        Table cipher(cols);
+        wstring encrypted = cipher.encrypt(text);
+        t = measure([&] { return cipher.encrypt(text).size(); }, it);
+        report("table", "encrypt", bytes, cols, chars, it, t);
+        t = measure([&] { return cipher.decrypt(encrypted).size(); }, it);
+        report("table", "decrypt", bytes, cols, letters.size(), it, t);
+        t = measure([&] {
+            readColumns(letters.data(), letters.size(), static_cast<size_t>(cols), &out[0]);
+            return out.size();
+        }, it);
+        report("table", "transform", bytes, cols, letters.size(), it, t);
+    }
+}
+
+/**
+ * @brief Главная функция набора замеров
+ * @param [in] argc Количество аргументов
+ * @param [in] argv Аргументы командной строки
+ * @return 0 при успехе, 2 при неверных аргументах
+ */
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--max-size=", 11) == 0) {
+            options.maxSize = strtoull(argv[i] + 11, nullptr, 10);
+        } else if (strncmp(argv[i], "--min-time=", 11) == 0) {
+            options.minTime = strtod(argv[i] + 11, nullptr);
+        } else if (strcmp(argv[i], "--format=json") == 0) {
+            options.json = true;
+        } else if (strcmp(argv[i], "--format=csv") != 0) {
+            fprintf(stderr, "Usage: %s [--max-size=BYTES] [--min-time=SECONDS] [--format=csv|json]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (!options.json)
+        printf("cipher,op,bytes,param,iterations,ns_per_char,gb_per_s,kernel\n");
+    // Размеры от 16 Б до 1 ГБ с шагом 4x
+    for (size_t bytes = 16; bytes <= options.maxSize && bytes <= (size_t(1) << 30); bytes *= 4)
+        runSize(bytes);
+    return 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file modAlphabet.h
+ * @brief Общий модуль русского алфавита для обоих шифров
+ * @details Таблицы прямой индексации "символ-номер", "номер-символ" и
+ * приведения к верхнему регистру строятся на этапе компиляции и покрывают
+ * кириллический блок U+0400..U+045F, включая буквы Ё/ё. Для UTF-8 все
+ * русские буквы кодируются двухбайтовыми последовательностями
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Вспомогательные таблицы алфавита, строящиеся при компиляции
+ */
+namespace alphabet_detail {
+
+/// Русский алфавит в порядке номеров букв
+constexpr wchar_t letters[] = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+/// Первый символ покрываемого диапазона
+constexpr wchar_t base = 0x0400;
+/// Размер покрываемого диапазона (U+0400..U+045F)
+constexpr int span = 0x60;
+
+/**
+ * @brief Набор таблиц прямой индексации
+ */
+struct Tables {
+    int8_t anyIndex[span];   ///< Номер буквы любого регистра или -1
+    int8_t upperIndex[span]; ///< Номер прописной буквы или -1
+};
+
+/**
+ * @brief Построение таблиц по строке алфавита
+ * @return Заполненные таблицы
+ */
+constexpr Tables build() {
+    Tables t{};
+    for (int i = 0; i < span; ++i) {
+        t.anyIndex[i] = -1;
+        t.upperIndex[i] = -1;
+    }
+    for (int i = 0; i < 33; ++i) {
+        int up = letters[i] - base;
+        // Строчная буква: +0x20 для А..Я, +0x50 для Ё
+        int low = up + (letters[i] == L'Ё' ? 0x50 : 0x20);
+        t.anyIndex[up] = static_cast<int8_t>(i);
+        t.upperIndex[up] = static_cast<int8_t>(i);
+        t.anyIndex[low] = static_cast<int8_t>(i);
+    }
+    return t;
+}
+
+/// Таблицы, вычисленные на этапе компиляции
+inline constexpr Tables tables = build();
+
+}
+
+/**
+ * @brief Русский алфавит из 33 букв
+ * @details Все операции выполняются за O(1) чтением из таблиц без
+ * обращения к функциям локали
+ */
+class Alphabet {
+public:
+    /// Количество букв в алфавите
+    static constexpr int size = 33;
+
+    /**
+     * @brief Номер буквы любого регистра
+     * @param [in] c Символ
+     * @return Номер буквы 0..32 или -1, если символ не является русской буквой
+     */
+    static constexpr int index(wchar_t c) noexcept {
+        auto off = static_cast<unsigned long>(c) - alphabet_detail::base;
+        return off < alphabet_detail::span ? alphabet_detail::tables.anyIndex[off] : -1;
+    }
+
+    /**
+     * @brief Номер прописной буквы
+     * @param [in] c Символ
+     * @return Номер буквы 0..32 или -1, если символ не является прописной русской буквой
+     */
+    static constexpr int upperIndex(wchar_t c) noexcept {
+        auto off = static_cast<unsigned long>(c) - alphabet_detail::base;
+        return off < alphabet_detail::span ? alphabet_detail::tables.upperIndex[off] : -1;
+    }
+
+    /**
+     * @brief Прописная буква по номеру
+     * @param [in] i Номер буквы 0..32
+     * @return Прописная буква
+     */
+    static constexpr wchar_t letter(int i) noexcept {
+        return alphabet_detail::letters[i];
+    }
+
+    /**
+     * @brief Приведение русской буквы к верхнему регистру
+     * @param [in] c Символ
+     * @return Прописная буква или исходный символ, если он не является русской буквой
+     */
+    static constexpr wchar_t toUpper(wchar_t c) noexcept {
+        int i = index(c);
+        return i < 0 ? c : letter(i);
+    }
+
+    /**
+     * @brief Поиск первого символа, не являющегося прописной русской буквой
+     * @param [in] s Текст
+     * @param [in] n Длина текста
+     * @return Позиция первого такого символа или n, если его нет
+     */
+    static size_t findNonUpper(const wchar_t* s, size_t n) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            if (upperIndex(s[i]) < 0)
+                return i;
+        }
+        return n;
+    }
+
+    /**
+     * @brief Длина последовательности UTF-8 по первому байту
+     * @param [in] lead Первый байт последовательности
+     * @return Длина 1..4 (1 для ASCII и одиночных байтов продолжения)
+     */
+    static constexpr int utf8Length(unsigned char lead) noexcept {
+        return lead < 0xC0 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+    }
+
+    /**
+     * @brief Номер буквы любого регистра по двухбайтовой последовательности UTF-8
+     * @param [in] b0 Первый байт
+     * @param [in] b1 Второй байт
+     * @return Номер буквы 0..32 или -1
+     */
+    static constexpr int utf8Index(unsigned char b0, unsigned char b1) noexcept {
+        return (b1 & 0xC0) == 0x80 ? index(static_cast<wchar_t>(((b0 & 0x1F) << 6) | (b1 & 0x3F))) : -1;
+    }
+
+    /**
+     * @brief Разбор очередного символа UTF-8
+     * @details Позиция сдвигается за ведущий байт и только за следующие за
+     * ним байты продолжения, поэтому оборванная последовательность не
+     * поглощает ведущий байт следующего символа
+     * @param [in,out] p Текущая позиция, p < end
+     * @param [in] end Конец данных
+     * @return Номер русской буквы любого регистра 0..32 или -1 для прочих символов
+     */
+    static int utf8Next(const unsigned char*& p, const unsigned char* end) noexcept {
+        const unsigned char* s = p++;
+        if (*s < 0xC0)
+            return -1;
+        int l = utf8Length(*s);
+        const unsigned char* last = s + l;
+        while (p < end && p < last && (*p & 0xC0) == 0x80)
+            ++p;
+        return l == 2 && p == last ? utf8Index(s[0], s[1]) : -1;
+    }
+
+    /**
+     * @brief Номер прописной буквы по двухбайтовой последовательности UTF-8
+     * @param [in] b0 Первый байт
+     * @param [in] b1 Второй байт
+     * @return Номер буквы 0..32 или -1
+     */
+    static constexpr int utf8UpperIndex(unsigned char b0, unsigned char b1) noexcept {
+        return (b1 & 0xC0) == 0x80 ? upperIndex(static_cast<wchar_t>(((b0 & 0x1F) << 6) | (b1 & 0x3F))) : -1;
+    }
+
+    /**
+     * @brief Запись прописной буквы в UTF-8
+     * @param [in] i Номер буквы 0..32
+     * @param [out] out Буфер не менее чем из двух байтов
+     */
+    static void utf8Letter(int i, char* out) noexcept {
+        unsigned c = static_cast<unsigned>(letter(i));
+        out[0] = static_cast<char>(0xC0 | (c >> 6));
+        out[1] = static_cast<char>(0x80 | (c & 0x3F));
+    }
+};
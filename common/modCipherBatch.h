@@ -0,0 +1,79 @@
+/**
+ * @file modCipherBatch.h
+ * @brief Общие типы пакетной обработки сообщений для обоих шифров
+ * @details Результаты всех сообщений пакета пишутся подряд в один буфер,
+ * а ошибки сообщаются отдельно для каждого сообщения
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include "modCipherStatus.h"
+
+/**
+ * @brief Результаты пакетной обработки сообщений
+ * @details Результат сообщения i занимает arena[offsets[i], offsets[i + 1]);
+ * для сообщений с ошибкой этот участок пуст. Объект можно передавать в
+ * следующие вызовы повторно: выделенная память сохраняется
+ */
+struct CipherBatch {
+    std::vector<wchar_t> arena;         ///< Результаты всех сообщений подряд
+    std::vector<size_t> offsets;        ///< Начала результатов, offsets.size() == size() + 1
+    std::vector<cipher_status> status;  ///< Состояние каждого сообщения
+
+    /**
+     * @brief Количество сообщений в пакете
+     * @return Количество сообщений
+     */
+    size_t size() const noexcept { return status.size(); }
+
+    /**
+     * @brief Результат сообщения
+     * @param [in] i Номер сообщения
+     * @return Результат (пустой для сообщения с ошибкой)
+     */
+    std::wstring_view result(size_t i) const noexcept {
+        return std::wstring_view(arena.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+
+    /**
+     * @brief Подготовка к обработке пакета
+     * @param [in] texts Входные сообщения
+     * @param [in] count Количество сообщений
+     * @return Указатель на начало буфера результатов
+     * @details Буфер вмещает суммарную длину входа, так как результат
+     * каждого сообщения не длиннее самого сообщения
+     */
+    wchar_t* prepare(const std::wstring_view* texts, size_t count) {
+        size_t total = 0;
+        for (size_t i = 0; i < count; ++i)
+            total += texts[i].size();
+        arena.resize(total);
+        offsets.assign(1, 0);
+        offsets.reserve(count + 1);
+        status.clear();
+        status.reserve(count);
+        return arena.data();
+    }
+
+    /**
+     * @brief Запись результата очередного сообщения
+     * @param [in] s Состояние сообщения
+     * @param [in] length Длина результата в буфере
+     */
+    void push(cipher_status s, size_t length) {
+        status.push_back(s);
+        offsets.push_back(offsets.back() + (s == cipher_status::ok ? length : 0));
+    }
+
+    /**
+     * @brief Завершение пакета: обрезка буфера до фактического размера
+     */
+    void finish() {
+        arena.resize(offsets.back());
+    }
+};
@@ -0,0 +1,50 @@
+/**
+ * @file modCipherError.h
+ * @brief Заголовочный файл класса исключений cipher_error
+ * @details Общий для обоих шифров, чтобы их можно было использовать в
+ * одной программе
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Класс исключений для ошибок шифрования
+ * @details Наследуется от std::invalid_argument
+ */
+class cipher_error : public std::invalid_argument {
+public:
+    /**
+     * @brief Конструктор с строковым параметром
+     * @param [in] what_arg Сообщение об ошибке
+     */
+    explicit cipher_error(const std::string& what_arg) : std::invalid_argument(what_arg) {}
+    
+    /**
+     * @brief Конструктор с C-строкой
+     * @param [in] what_arg Сообщение об ошибке
+     */
+    explicit cipher_error(const char* what_arg) : std::invalid_argument(what_arg) {}
+};
+
+#if defined(__GNUC__)
+/// Вынос редко выполняемой функции из горячего кода
+#define CIPHER_COLD __attribute__((noinline, cold))
+#else
+#define CIPHER_COLD
+#endif
+
+/**
+ * @brief Возбуждение cipher_error вне горячих циклов
+ * @details Функция не встраивается, поэтому код построения исключения не
+ * увеличивает циклы проверки и преобразования текста
+ * @param [in] what_arg Сообщение об ошибке
+ * @throw cipher_error Всегда
+ */
+[[noreturn]] CIPHER_COLD inline void throwCipherError(const char* what_arg) {
+    throw cipher_error(what_arg);
+}
@@ -0,0 +1,37 @@
+/**
+ * @file modCipherStatus.h
+ * @brief Коды результата для API без исключений
+ * @details Общие для обоих шифров: пакетная обработка и методы try*
+ * сообщают об ошибках кодом, а не исключением cipher_error
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Результат обработки одного сообщения
+ */
+enum class cipher_status : uint8_t {
+    ok,           ///< Сообщение обработано
+    empty_text,   ///< Текст пустой или не содержит букв
+    invalid_text, ///< Шифротекст содержит символ, не являющийся прописной русской буквой
+    invalid_key   ///< Ключ пустой или невалиден
+};
+
+/**
+ * @brief Результат проверки или преобразования без исключений
+ */
+struct cipher_result {
+    cipher_status status = cipher_status::ok; ///< Код результата
+    size_t position = 0;                      ///< Позиция первого недопустимого символа
+
+    /**
+     * @brief Проверка успешности
+     * @return true, если status == cipher_status::ok
+     */
+    explicit operator bool() const noexcept { return status == cipher_status::ok; }
+};
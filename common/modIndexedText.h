@@ -0,0 +1,144 @@
+/**
+ * @file modIndexedText.h
+ * @brief Общее однобайтовое представление текста для обоих шифров
+ * @details Текст хранится номерами букв алфавита 0..32 по одному байту на
+ * букву. Проверка и нормализация выполняются один раз при построении,
+ * поэтому шифры принимают IndexedText без повторной проверки
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "modAlphabet.h"
+#include "modCipherError.h"
+#include "modNormalize.h"
+
+/**
+ * @brief Текст из номеров букв алфавита
+ * @details Все элементы меньше Alphabet::size; изменять содержимое могут
+ * только шифры. Текст может быть пустым, если во входе не было букв
+ */
+class IndexedText {
+    friend class modAlphaCipher;
+    friend class Table;
+    friend class modRunningKeyCipher;
+private:
+    std::vector<uint8_t> idx; /// Номера букв
+
+    /**
+     * @brief Текст заданной длины для заполнения шифром
+     * @param [in] n Количество букв
+     */
+    explicit IndexedText(size_t n) : idx(n) {}
+
+public:
+    /**
+     * @brief Пустой текст
+     */
+    IndexedText() = default;
+
+    /**
+     * @brief Построение из открытого текста
+     * @details Не-буквенные символы отбрасываются, регистр не учитывается
+     * @param [in] s Открытый текст
+     * @return Номера букв текста
+     */
+    static IndexedText fromOpenText(std::wstring_view s) {
+        IndexedText t(s.size());
+        t.idx.resize(Normalize::indices(s.data(), s.size(), t.idx.data()));
+        return t;
+    }
+
+    /**
+     * @brief Построение из открытого текста в UTF-8
+     * @details Двухбайтовые последовательности русских букв разбираются
+     * напрямую, остальные символы отбрасываются
+     * @param [in] s Открытый текст в UTF-8
+     * @return Номера букв текста
+     */
+    static IndexedText fromUtf8(std::string_view s) {
+        IndexedText t;
+        t.idx.reserve(s.size() / 2);
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(s.data());
+        const unsigned char* end = p + s.size();
+        while (p < end) {
+            int i = Alphabet::utf8Next(p, end);
+            if (i >= 0)
+                t.idx.push_back(static_cast<uint8_t>(i));
+        }
+        return t;
+    }
+
+    /**
+     * @brief Построение из зашифрованного текста
+     * @param [in] s Текст из прописных букв
+     * @return Номера букв текста
+     * @throw cipher_error Если текст содержит не-прописные буквы
+     */
+    static IndexedText fromCipherText(std::wstring_view s) {
+        IndexedText t(s.size());
+        if (Normalize::upperIndices(s.data(), s.size(), t.idx.data()) != s.size())
+            throwCipherError("Invalid cipher text");
+        return t;
+    }
+
+    /**
+     * @brief Количество букв
+     * @return Длина текста
+     */
+    size_t size() const noexcept { return idx.size(); }
+
+    /**
+     * @brief Проверка на пустоту
+     * @return true, если текст не содержит букв
+     */
+    bool empty() const noexcept { return idx.empty(); }
+
+    /**
+     * @brief Номера букв
+     * @return Указатель на size() номеров
+     */
+    const uint8_t* data() const noexcept { return idx.data(); }
+
+    /**
+     * @brief Номер буквы
+     * @param [in] i Позиция
+     * @return Номер буквы 0..32
+     */
+    uint8_t operator[](size_t i) const noexcept { return idx[i]; }
+
+    /**
+     * @brief Преобразование в wstring прописными буквами
+     * @return Текст
+     */
+    std::wstring toWide() const {
+        std::wstring s(idx.size(), L'\0');
+        for (size_t i = 0; i < idx.size(); ++i)
+            s[i] = Alphabet::letter(idx[i]);
+        return s;
+    }
+
+    /**
+     * @brief Преобразование в UTF-8 прописными буквами
+     * @return Текст по два байта на букву
+     */
+    std::string toUtf8() const {
+        std::string s(2 * idx.size(), '\0');
+        for (size_t i = 0; i < idx.size(); ++i)
+            Alphabet::utf8Letter(idx[i], &s[2 * i]);
+        return s;
+    }
+
+    /**
+     * @brief Сравнение текстов
+     * @param [in] other Другой текст
+     * @return true, если номера букв совпадают
+     */
+    bool operator==(const IndexedText& other) const noexcept { return idx == other.idx; }
+};
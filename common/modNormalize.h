@@ -0,0 +1,391 @@
+/**
+ * @file modNormalize.h
+ * @brief Векторные ядра проверки и нормализации текста
+ * @details Символ c считается буквой без обращения к таблицам: для
+ * u = c - U+0410 буквы А..я дают u < 64, а Ё/ё проверяются отдельно.
+ * Регистр снимается вычитанием 32 при u >= 32, номер буквы равен
+ * u + (u >= 6), потому что Ё стоит на месте 6. Оставшиеся буквы
+ * уплотняются инструкцией compress (AVX-512) или перестановкой по
+ * таблице (AVX2). Реализация выбирается во время выполнения; результат
+ * совпадает со скалярными функциями Alphabet
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "modAlphabet.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && __WCHAR_MAX__ > 0xFFFF
+#include <immintrin.h>
+#define NORMALIZE_X86 1
+#endif
+
+/**
+ * @brief Реализации ядер нормализации
+ */
+namespace normalize_detail {
+
+/// Первая прописная буква А..Я
+constexpr unsigned upperBase = 0x0410;
+/// Прописная Ё
+constexpr unsigned upperYo = 0x0401;
+/// Строчная ё
+constexpr unsigned lowerYo = 0x0451;
+
+/**
+ * @brief Скалярное уплотнение номеров букв любого регистра
+ */
+inline size_t indicesScalar(const wchar_t* s, size_t n, uint8_t* out) noexcept
+{
+    size_t m = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int k = Alphabet::index(s[i]);
+        out[m] = static_cast<uint8_t>(k);
+        m += k >= 0;
+    }
+    return m;
+}
+
+/**
+ * @brief Скалярное уплотнение букв с приведением к верхнему регистру
+ */
+inline size_t lettersScalar(const wchar_t* s, size_t n, wchar_t* out) noexcept
+{
+    size_t m = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int k = Alphabet::index(s[i]);
+        if (k >= 0)
+            out[m++] = Alphabet::letter(k);
+    }
+    return m;
+}
+
+/**
+ * @brief Скалярный перевод прописных букв в номера
+ */
+inline size_t upperScalar(const wchar_t* s, size_t n, uint8_t* out) noexcept
+{
+    for (size_t i = 0; i < n; ++i) {
+        int k = Alphabet::upperIndex(s[i]);
+        if (k < 0)
+            return i;
+        out[i] = static_cast<uint8_t>(k);
+    }
+    return n;
+}
+
+#if defined(NORMALIZE_X86)
+/**
+ * @brief Таблица уплотнения 8 дорожек
+ * @details Для маски оставляемых дорожек - номера этих дорожек подряд
+ */
+struct CompressTable {
+    uint8_t lanes[256][8]; ///< Номера дорожек для каждой маски
+};
+
+/**
+ * @brief Построение таблицы уплотнения
+ * @return Заполненная таблица
+ */
+constexpr CompressTable buildCompress()
+{
+    CompressTable t{};
+    for (int mask = 0; mask < 256; ++mask) {
+        int k = 0;
+        for (int lane = 0; lane < 8; ++lane) {
+            if (mask & (1 << lane))
+                t.lanes[mask][k++] = static_cast<uint8_t>(lane);
+        }
+    }
+    return t;
+}
+
+/// Таблица уплотнения, вычисленная на этапе компиляции
+inline constexpr CompressTable compressTable = buildCompress();
+
+/**
+ * @brief Разбор 8 символов (AVX2)
+ * @param [in] c Символы
+ * @param [out] idx Номера букв (только для дорожек букв)
+ * @return Маска дорожек, содержащих буквы любого регистра
+ */
+__attribute__((target("avx2")))
+inline unsigned classify8(__m256i c, __m256i& idx) noexcept
+{
+    const __m256i u = _mm256_sub_epi32(c, _mm256_set1_epi32(upperBase));
+    const __m256i inRange = _mm256_cmpeq_epi32(_mm256_min_epu32(u, _mm256_set1_epi32(63)), u);
+    const __m256i yo = _mm256_or_si256(_mm256_cmpeq_epi32(c, _mm256_set1_epi32(upperYo)),
+                                       _mm256_cmpeq_epi32(c, _mm256_set1_epi32(lowerYo)));
+    // Снятие регистра и пропуск места Ё: f - (f > 5), где сравнение дает -1
+    __m256i f = _mm256_sub_epi32(u, _mm256_and_si256(_mm256_cmpgt_epi32(u, _mm256_set1_epi32(31)),
+                                                     _mm256_set1_epi32(32)));
+    f = _mm256_sub_epi32(f, _mm256_cmpgt_epi32(f, _mm256_set1_epi32(5)));
+    idx = _mm256_blendv_epi8(f, _mm256_set1_epi32(6), yo);
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_or_si256(inRange, yo))));
+}
+
+/**
+ * @brief Младшие байты 8 32-битных дорожек (AVX2)
+ * @param [in] v Дорожки со значениями 0..255
+ * @return 8 байтов в младших 64 битах
+ */
+__attribute__((target("avx2")))
+inline __m128i packBytes8(__m256i v) noexcept
+{
+    const __m256i pick = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                          0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    v = _mm256_shuffle_epi8(v, pick);
+    return _mm_unpacklo_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+}
+
+/**
+ * @brief Уплотнение номеров букв (AVX2)
+ * @details Запись 8 байтов по позиции m <= i не выходит за n байтов out
+ */
+__attribute__((target("avx2")))
+inline size_t indicesAvx2(const wchar_t* s, size_t n, uint8_t* out) noexcept
+{
+    size_t m = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i idx;
+        unsigned keep = classify8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i)), idx);
+        __m256i perm = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(compressTable.lanes[keep])));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + m), packBytes8(_mm256_permutevar8x32_epi32(idx, perm)));
+        m += static_cast<size_t>(__builtin_popcount(keep));
+    }
+    return m + indicesScalar(s + i, n - i, out + m);
+}
+
+/**
+ * @brief Уплотнение букв с приведением к верхнему регистру (AVX2)
+ */
+__attribute__((target("avx2")))
+inline size_t lettersAvx2(const wchar_t* s, size_t n, wchar_t* out) noexcept
+{
+    size_t m = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        __m256i idx;
+        unsigned keep = classify8(c, idx);
+        // Номер обратно в прописную букву: А..Я подряд, Ё отдельно
+        __m256i yo = _mm256_cmpeq_epi32(idx, _mm256_set1_epi32(6));
+        __m256i up = _mm256_add_epi32(_mm256_add_epi32(idx, _mm256_set1_epi32(upperBase)),
+                                      _mm256_cmpgt_epi32(idx, _mm256_set1_epi32(6)));
+        up = _mm256_blendv_epi8(up, _mm256_set1_epi32(upperYo), yo);
+        __m256i perm = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(compressTable.lanes[keep])));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + m), _mm256_permutevar8x32_epi32(up, perm));
+        m += static_cast<size_t>(__builtin_popcount(keep));
+    }
+    return m + lettersScalar(s + i, n - i, out + m);
+}
+
+/**
+ * @brief Маска прописных букв среди 8 символов (AVX2)
+ * @param [in] c Символы
+ * @param [out] idx Номера букв
+ * @return Маска дорожек с прописными буквами
+ */
+__attribute__((target("avx2")))
+inline unsigned upper8(__m256i c, __m256i& idx) noexcept
+{
+    const __m256i u = _mm256_sub_epi32(c, _mm256_set1_epi32(upperBase));
+    const __m256i inRange = _mm256_cmpeq_epi32(_mm256_min_epu32(u, _mm256_set1_epi32(31)), u);
+    const __m256i yo = _mm256_cmpeq_epi32(c, _mm256_set1_epi32(upperYo));
+    __m256i f = _mm256_sub_epi32(u, _mm256_cmpgt_epi32(u, _mm256_set1_epi32(5)));
+    idx = _mm256_blendv_epi8(f, _mm256_set1_epi32(6), yo);
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_or_si256(inRange, yo))));
+}
+
+/**
+ * @brief Перевод прописных букв в номера с проверкой (AVX2)
+ */
+__attribute__((target("avx2")))
+inline size_t upperAvx2(const wchar_t* s, size_t n, uint8_t* out) noexcept
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i idx;
+        if (upper8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i)), idx) != 0xFF)
+            return i + upperScalar(s + i, 8, out + i);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), packBytes8(idx));
+    }
+    return i + upperScalar(s + i, n - i, out + i);
+}
+
+/**
+ * @brief Поиск первого символа, не являющегося прописной буквой (AVX2)
+ */
+__attribute__((target("avx2")))
+inline size_t findAvx2(const wchar_t* s, size_t n) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i a, b;
+        unsigned ka = upper8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i)), a);
+        unsigned kb = upper8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 8)), b);
+        unsigned bad = ~(ka | kb << 8) & 0xFFFF;
+        if (bad)
+            return i + static_cast<size_t>(__builtin_ctz(bad));
+    }
+    return i + Alphabet::findNonUpper(s + i, n - i);
+}
+
+/**
+ * @brief Разбор 16 символов (AVX-512)
+ * @param [in] c Символы
+ * @param [out] idx Номера букв (только для дорожек букв)
+ * @return Маска дорожек, содержащих буквы любого регистра
+ */
+__attribute__((target("avx512f,avx512bw")))
+inline __mmask16 classify16(__m512i c, __m512i& idx) noexcept
+{
+    const __m512i u = _mm512_sub_epi32(c, _mm512_set1_epi32(upperBase));
+    __mmask16 yo = _mm512_cmpeq_epi32_mask(c, _mm512_set1_epi32(upperYo)) |
+                   _mm512_cmpeq_epi32_mask(c, _mm512_set1_epi32(lowerYo));
+    __mmask16 keep = _mm512_cmplt_epu32_mask(u, _mm512_set1_epi32(64)) | yo;
+    __m512i f = _mm512_mask_sub_epi32(u, _mm512_cmpge_epu32_mask(u, _mm512_set1_epi32(32)), u, _mm512_set1_epi32(32));
+    f = _mm512_mask_add_epi32(f, _mm512_cmpgt_epu32_mask(f, _mm512_set1_epi32(5)), f, _mm512_set1_epi32(1));
+    idx = _mm512_mask_mov_epi32(f, yo, _mm512_set1_epi32(6));
+    return keep;
+}
+
+/**
+ * @brief Уплотнение номеров букв (AVX-512)
+ */
+__attribute__((target("avx512f,avx512bw")))
+inline size_t indicesAvx512(const wchar_t* s, size_t n, uint8_t* out) noexcept
+{
+    size_t m = 0, i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i idx;
+        __mmask16 keep = classify16(_mm512_loadu_si512(s + i), idx);
+        unsigned count = static_cast<unsigned>(__builtin_popcount(keep));
+        _mm512_mask_cvtepi32_storeu_epi8(out + m, static_cast<__mmask16>((1u << count) - 1),
+                                         _mm512_maskz_compress_epi32(keep, idx));
+        m += count;
+    }
+    return m + indicesScalar(s + i, n - i, out + m);
+}
+
+/**
+ * @brief Уплотнение букв с приведением к верхнему регистру (AVX-512)
+ */
+__attribute__((target("avx512f,avx512bw")))
+inline size_t lettersAvx512(const wchar_t* s, size_t n, wchar_t* out) noexcept
+{
+    size_t m = 0, i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i idx;
+        __mmask16 keep = classify16(_mm512_loadu_si512(s + i), idx);
+        __m512i up = _mm512_add_epi32(idx, _mm512_set1_epi32(upperBase));
+        up = _mm512_mask_sub_epi32(up, _mm512_cmpgt_epu32_mask(idx, _mm512_set1_epi32(6)), up, _mm512_set1_epi32(1));
+        up = _mm512_mask_mov_epi32(up, _mm512_cmpeq_epi32_mask(idx, _mm512_set1_epi32(6)), _mm512_set1_epi32(upperYo));
+        _mm512_storeu_si512(out + m, _mm512_maskz_compress_epi32(keep, up));
+        m += static_cast<size_t>(__builtin_popcount(keep));
+    }
+    return m + lettersScalar(s + i, n - i, out + m);
+}
+#endif
+
+/**
+ * @brief Описание выбранных реализаций
+ */
+struct NormalizeImpl {
+    size_t (*indices)(const wchar_t*, size_t, uint8_t*) noexcept; ///< Уплотнение номеров
+    size_t (*letters)(const wchar_t*, size_t, wchar_t*) noexcept; ///< Уплотнение букв
+    size_t (*upper)(const wchar_t*, size_t, uint8_t*) noexcept;   ///< Номера прописных букв
+    size_t (*find)(const wchar_t*, size_t) noexcept;              ///< Поиск не-прописного символа
+    const char* name;                                             ///< Название реализации
+};
+
+/**
+ * @brief Выбор реализаций по возможностям процессора
+ * @details Проверка прописных букв не выигрывает от compress и на
+ * AVX-512 использует ядра AVX2
+ * @return Лучшие доступные реализации
+ */
+inline NormalizeImpl selectNormalize() noexcept
+{
+#if defined(NORMALIZE_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw"))
+        return {indicesAvx512, lettersAvx512, upperAvx2, findAvx2, "avx512"};
+    if (__builtin_cpu_supports("avx2"))
+        return {indicesAvx2, lettersAvx2, upperAvx2, findAvx2, "avx2"};
+#endif
+    return {indicesScalar, lettersScalar, upperScalar, Alphabet::findNonUpper, "scalar"};
+}
+
+/**
+ * @brief Реализации, выбранные при первом обращении
+ */
+inline const NormalizeImpl& normalizeImpl() noexcept
+{
+    static const NormalizeImpl impl = selectNormalize();
+    return impl;
+}
+
+}
+
+/**
+ * @brief Нормализация и проверка текста векторными ядрами
+ * @details Те же операции, что и посимвольные функции Alphabet, над
+ * целыми участками текста. Выходной буфер должен вмещать n элементов,
+ * даже если букв меньше: ядра записывают полные векторы
+ */
+class Normalize {
+public:
+    /**
+     * @brief Номера букв любого регистра подряд
+     * @param [in] s Текст
+     * @param [in] n Длина текста
+     * @param [out] out Буфер номеров длиной не менее n
+     * @return Количество букв; прочие символы пропускаются
+     */
+    static size_t indices(const wchar_t* s, size_t n, uint8_t* out) noexcept {
+        return normalize_detail::normalizeImpl().indices(s, n, out);
+    }
+
+    /**
+     * @brief Буквы любого регистра подряд, приведенные к верхнему регистру
+     * @param [in] s Текст
+     * @param [in] n Длина текста
+     * @param [out] out Буфер длиной не менее n; может совпадать с s
+     * @return Количество букв
+     */
+    static size_t letters(const wchar_t* s, size_t n, wchar_t* out) noexcept {
+        return normalize_detail::normalizeImpl().letters(s, n, out);
+    }
+
+    /**
+     * @brief Номера прописных букв с проверкой текста
+     * @param [in] s Текст
+     * @param [in] n Длина текста
+     * @param [out] out Буфер номеров длиной не менее n
+     * @return n или позиция первого символа, не являющегося прописной буквой
+     */
+    static size_t upperIndices(const wchar_t* s, size_t n, uint8_t* out) noexcept {
+        return normalize_detail::normalizeImpl().upper(s, n, out);
+    }
+
+    /**
+     * @brief Поиск первого символа, не являющегося прописной русской буквой
+     * @param [in] s Текст
+     * @param [in] n Длина текста
+     * @return Позиция первого такого символа или n, если его нет
+     */
+    static size_t findNonUpper(const wchar_t* s, size_t n) noexcept {
+        return normalize_detail::normalizeImpl().find(s, n);
+    }
+
+    /**
+     * @brief Название выбранной реализации
+     * @return "avx512", "avx2" или "scalar"
+     */
+    static const char* kernelName() noexcept {
+        return normalize_detail::normalizeImpl().name;
+    }
+};
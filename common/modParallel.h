@@ -0,0 +1,63 @@
+/**
+ * @file modParallel.h
+ * @brief Общий модуль параллельного выполнения для шифров
+ * @details Запуск независимых задач на нескольких потоках с передачей
+ * исключений в вызывающий поток
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Количество потоков для параллельного режима
+ * @param [in] requested Запрошенное количество (0 - по числу ядер)
+ * @return Количество потоков, не меньше 1
+ */
+inline unsigned parallelThreads(unsigned requested) {
+    if (requested == 0)
+        requested = std::thread::hardware_concurrency();
+    return std::max(1u, requested);
+}
+
+/**
+ * @brief Выполнение задач 0..tasks-1 на нескольких потоках
+ * @details Вызывающий поток участвует в работе. Задачи разбираются через
+ * атомарный счетчик; первое возникшее исключение передается вызывающему
+ * потоку после завершения всех потоков
+ * @param [in] tasks Количество задач
+ * @param [in] threads Количество потоков
+ * @param [in] f Функция f(size_t task)
+ */
+template <class F>
+void parallelFor(size_t tasks, unsigned threads, F&& f) {
+    std::atomic<size_t> next{0};
+    std::vector<std::exception_ptr> errors(tasks);
+    auto worker = [&]() {
+        for (size_t t = next++; t < tasks; t = next++) {
+            try {
+                f(t);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    size_t extra = std::min<size_t>(threads, tasks);
+    for (size_t i = 1; i < extra; ++i)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool)
+        th.join();
+    for (auto& e : errors) {
+        if (e)
+            std::rethrow_exception(e);
+    }
+}
@@ -0,0 +1,166 @@
+/**
+ * @file modStats.h
+ * @brief Общий модуль счетчиков и замеров времени для обоих шифров
+ * @details Счетчики включаются определением макроса CIPHER_STATS при
+ * сборке; без него макросы CIPHER_STATS_* не порождают кода, а снимок
+ * содержит нули. Счетчики - атомарные переменные с упорядочением relaxed,
+ * поэтому снимок можно снимать из другого потока без блокировок.
+ * Счетчики обновляются один раз на вызов или блок, а не на символ
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "modCipherStatus.h"
+
+/**
+ * @brief Стадии обработки текста
+ * @details Если стадии выполняются одним циклом (например, фильтрация и
+ * преобразование в номера букв), время относится к первой из них
+ */
+enum class cipher_stage : uint8_t {
+    validate,  ///< Проверка и фильтрация входа
+    convert,   ///< Преобразование символов в номера букв
+    transform, ///< Сдвиг или перестановка
+    emit,      ///< Запись результата
+    count      ///< Количество стадий
+};
+
+/// Количество кодов cipher_status
+constexpr size_t cipherStatusCount = static_cast<size_t>(cipher_status::invalid_key) + 1;
+
+/**
+ * @brief Снимок счетчиков
+ */
+struct CipherStatsSnapshot {
+    uint64_t charsIn = 0;                                              ///< Символов на входе
+    uint64_t lettersKept = 0;                                          ///< Букв оставлено фильтрацией
+    uint64_t lettersDropped = 0;                                       ///< Символов отброшено фильтрацией
+    uint64_t charsOut = 0;                                             ///< Символов на выходе
+    uint64_t rejected[cipherStatusCount] = {};                         ///< Отказов по кодам cipher_status
+    uint64_t stageNanos[static_cast<size_t>(cipher_stage::count)] = {}; ///< Время по стадиям, нс
+};
+
+/**
+ * @brief Набор счетчиков одного шифра
+ */
+class CipherStats {
+private:
+    std::atomic<uint64_t> charsIn{0};                                              /// Символов на входе
+    std::atomic<uint64_t> lettersKept{0};                                          /// Букв оставлено
+    std::atomic<uint64_t> lettersDropped{0};                                       /// Символов отброшено
+    std::atomic<uint64_t> charsOut{0};                                             /// Символов на выходе
+    std::atomic<uint64_t> rejected[cipherStatusCount] = {};                        /// Отказов по кодам
+    std::atomic<uint64_t> stageNanos[static_cast<size_t>(cipher_stage::count)] = {}; /// Время по стадиям
+
+public:
+    /**
+     * @brief Учет входа и результата фильтрации
+     * @param [in] in Символов на входе
+     * @param [in] kept Букв оставлено
+     */
+    void input(uint64_t in, uint64_t kept) noexcept {
+        charsIn.fetch_add(in, std::memory_order_relaxed);
+        lettersKept.fetch_add(kept, std::memory_order_relaxed);
+        lettersDropped.fetch_add(in - kept, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Учет выхода
+     * @param [in] out Символов на выходе
+     */
+    void output(uint64_t out) noexcept {
+        charsOut.fetch_add(out, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Учет отказа
+     * @param [in] reason Причина отказа
+     */
+    void reject(cipher_status reason) noexcept {
+        rejected[static_cast<size_t>(reason)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Учет времени стадии
+     * @param [in] stage Стадия
+     * @param [in] nanos Время в наносекундах
+     */
+    void time(cipher_stage stage, uint64_t nanos) noexcept {
+        stageNanos[static_cast<size_t>(stage)].fetch_add(nanos, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Снимок счетчиков без блокировок
+     * @details Счетчики читаются по отдельности, поэтому при
+     * одновременном шифровании снимок может не быть согласован между полями
+     * @return Текущие значения
+     */
+    CipherStatsSnapshot snapshot() const noexcept {
+        CipherStatsSnapshot s;
+        s.charsIn = charsIn.load(std::memory_order_relaxed);
+        s.lettersKept = lettersKept.load(std::memory_order_relaxed);
+        s.lettersDropped = lettersDropped.load(std::memory_order_relaxed);
+        s.charsOut = charsOut.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < cipherStatusCount; ++i)
+            s.rejected[i] = rejected[i].load(std::memory_order_relaxed);
+        for (size_t i = 0; i < static_cast<size_t>(cipher_stage::count); ++i)
+            s.stageNanos[i] = stageNanos[i].load(std::memory_order_relaxed);
+        return s;
+    }
+};
+
+/**
+ * @brief Замер времени стадии до конца области видимости
+ */
+class CipherStageTimer {
+private:
+    CipherStats& stats;                                  /// Счетчики шифра
+    cipher_stage stage;                                  /// Замеряемая стадия
+    std::chrono::steady_clock::time_point start;         /// Начало замера
+
+public:
+    /**
+     * @brief Начало замера
+     * @param [in] s Счетчики шифра
+     * @param [in] st Замеряемая стадия
+     */
+    CipherStageTimer(CipherStats& s, cipher_stage st) noexcept
+        : stats(s), stage(st), start(std::chrono::steady_clock::now()) {}
+
+    CipherStageTimer(const CipherStageTimer&) = delete;
+    CipherStageTimer& operator=(const CipherStageTimer&) = delete;
+
+    /**
+     * @brief Окончание замера и учет времени
+     */
+    ~CipherStageTimer() {
+        auto d = std::chrono::steady_clock::now() - start;
+        stats.time(stage, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()));
+    }
+};
+
+#define CIPHER_STATS_CONCAT2(a, b) a##b
+#define CIPHER_STATS_CONCAT(a, b) CIPHER_STATS_CONCAT2(a, b)
+
+#if defined(CIPHER_STATS)
+/// Учет входа: in символов, kept из них оставлено
+#define CIPHER_STATS_INPUT(stats, in, kept) (stats).input((in), (kept))
+/// Учет выхода
+#define CIPHER_STATS_OUTPUT(stats, out) (stats).output(out)
+/// Учет отказа по коду cipher_status
+#define CIPHER_STATS_REJECT(stats, reason) (stats).reject(reason)
+/// Замер времени стадии до конца текущей области видимости
+#define CIPHER_STATS_TIMER(stats, stage) \
+    CipherStageTimer CIPHER_STATS_CONCAT(cipherStageTimer, __LINE__)((stats), (stage))
+#else
+#define CIPHER_STATS_INPUT(stats, in, kept) ((void)0)
+#define CIPHER_STATS_OUTPUT(stats, out) ((void)0)
+#define CIPHER_STATS_REJECT(stats, reason) ((void)0)
+#define CIPHER_STATS_TIMER(stats, stage) ((void)0)
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file modProductCipher.cpp
+ * @brief Реализация класса modProductCipher
+ * @details Содержит объединенные проходы шифрования и дешифрования
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include "modProductCipher.h"
+#include <algorithm>
+#include <vector>
+#include "../2.2/modTranspose.h"
+
+/**
+ * @brief Конструктор по ключам обеих ступеней
+ * @param [in] key Ключ шифра Гронсфельда
+ * @param [in] cols Количество столбцов таблицы
+ * @throw cipher_error Если хотя бы один ключ невалиден
+ */
+modProductCipher::modProductCipher(const std::wstring& key, int cols) : alpha(key), table(cols) {
+}
+
+/**
+ * @brief Шифрование открытого текста обеими ступенями
+ * @param [in] open_text Открытый текст для шифрования
+ * @return Зашифрованный текст
+ * @throw cipher_error Если текст не содержит букв
+ */
+std::wstring modProductCipher::encrypt(const std::wstring& open_text) const {
+    const size_t len = open_text.size();
+    // Фильтрация и сдвиг блоками, пока блок находится в кэше
+    std::vector<uint8_t> work(len);
+    size_t n = 0;
+    size_t phase = 0;
+    for (size_t pos = 0; pos < len; ) {
+        size_t start = n;
+        size_t step = std::min(blockSize, len - pos);
+        n += Normalize::indices(open_text.data() + pos, step, work.data() + n);
+        pos += step;
+        phase = alpha.shiftBlock(work.data() + start, n - start, false, phase);
+    }
+    if (n == 0) {
+        throwCipherError("Empty text, no letters");
+    }
+
+    const size_t cols = transpose_detail::usedCols(n, static_cast<size_t>(table.cols));
+    std::wstring result(n, L'\0');
+    if (n < transposeThreshold || cols == 1) {
+        // Чтение по столбцам справа налево с записью букв
+        size_t rows = (n + cols - 1) / cols;
+        size_t fullCols = n % cols == 0 ? cols : n % cols;
+        wchar_t* d = &result[0];
+        for (size_t col = cols; col-- > 0; ) {
+            size_t rowsInCol = col < fullCols ? rows : rows - 1;
+            const uint8_t* p = work.data() + col;
+            for (size_t row = 0; row < rowsInCol; ++row, p += cols) {
+                *d++ = Alphabet::letter(*p);
+            }
+        }
+    } else {
+        // Блочная перестановка однобайтовых номеров, затем запись букв
+        std::vector<uint8_t> permuted(n);
+        readColumns(work.data(), n, cols, permuted.data());
+        for (size_t i = 0; i < n; ++i) {
+            result[i] = Alphabet::letter(permuted[i]);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Дешифрование зашифрованного текста обеими ступенями
+ * @param [in] cipher_text Зашифрованный текст для дешифрования
+ * @return Расшифрованный текст
+ * @throw cipher_error Если текст невалиден
+ */
+std::wstring modProductCipher::decrypt(const std::wstring& cipher_text) const {
+    const size_t n = cipher_text.size();
+    if (n == 0) {
+        throwCipherError("Empty cipher text");
+    }
+    // Проверка и преобразование в номера букв
+    std::vector<uint8_t> work(n);
+    if (Normalize::upperIndices(cipher_text.data(), n, work.data()) != n) {
+        throwCipherError("Invalid cipher text");
+    }
+
+    // Обратная перестановка номеров
+    std::vector<uint8_t> plain(n);
+    writeColumns(work.data(), n, static_cast<size_t>(table.cols), plain.data());
+
+    // Обратный сдвиг блоками с записью букв
+    std::wstring result(n, L'\0');
+    size_t phase = 0;
+    for (size_t start = 0; start < n; start += blockSize) {
+        size_t m = std::min(blockSize, n - start);
+        uint8_t* block = plain.data() + start;
+        phase = alpha.shiftBlock(block, m, true, phase);
+        for (size_t j = 0; j < m; ++j) {
+            result[start + j] = Alphabet::letter(block[j]);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file modProductCipher.h
+ * @brief Заголовочный файл для класса modProductCipher
+ * @details Составной шифр: шифр Гронсфельда, затем табличная маршрутная
+ * перестановка, за один проход проверки текста
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <string>
+#include "../2.1/modAlphaCipher.h"
+#include "../2.2/modTableCipher.h"
+
+/**
+ * @brief Класс составного шифра Гронсфельда и маршрутной перестановки
+ * @details Результат совпадает с Table(cols).encrypt(modAlphaCipher(key).encrypt(text)),
+ * но текст проверяется один раз, промежуточная wstring не создается, а
+ * сдвиг выполняется над однобайтовыми номерами букв до перестановки
+ */
+class modProductCipher {
+private:
+    modAlphaCipher alpha; /// Первая ступень: шифр Гронсфельда
+    Table table;          /// Вторая ступень: маршрутная перестановка
+
+    /// Размер блока номеров букв, обрабатываемого ядром сдвига за раз
+    static constexpr size_t blockSize = 4096;
+
+public:
+    /**
+     * @brief Конструктор по ключам обеих ступеней
+     * @param [in] key Ключ шифра Гронсфельда
+     * @param [in] cols Количество столбцов таблицы
+     * @throw cipher_error Если хотя бы один ключ невалиден
+     */
+    modProductCipher(const std::wstring& key, int cols);
+
+    /**
+     * @brief Шифрование открытого текста обеими ступенями
+     * @details Фильтрация и сдвиг выполняются одним последовательным
+     * проходом по входу, перестановка и запись букв - одним проходом по
+     * результату. Для длинных текстов перестановка выполняется блочным
+     * обходом над однобайтовыми номерами
+     * @param [in] open_text Открытый текст для шифрования
+     * @return Зашифрованный текст
+     * @throw cipher_error Если текст не содержит букв
+     */
+    std::wstring encrypt(const std::wstring& open_text) const;
+
+    /**
+     * @brief Дешифрование зашифрованного текста обеими ступенями
+     * @details Обратное преобразование: проверка и обратная перестановка
+     * номеров, затем обратный сдвиг с записью букв
+     * @param [in] cipher_text Зашифрованный текст для дешифрования
+     * @return Расшифрованный текст
+     * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+     */
+    std::wstring decrypt(const std::wstring& cipher_text) const;
+};
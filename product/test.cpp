@@ -0,0 +1,115 @@
+/**
+ * @file test.cpp
+ * @brief Модульные тесты для класса modProductCipher
+ * @details Сравнивает составной шифр с последовательным применением
+ * modAlphaCipher и Table
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include <UnitTest++/UnitTest++.h>
+#include <string>
+#include <locale>
+#include <codecvt>
+#include "modProductCipher.h"
+#include "../2.2/modTranspose.h"
+
+using namespace std;
+
+/**
+ * @brief Преобразование wide string в UTF-8 string
+ * @param [in] ws Строка в формате wstring
+ * @return Строка в формате UTF-8
+ */
+string wideToUtf8(const wstring& ws) {
+    wstring_convert<codecvt_utf8<wchar_t>> conv;
+    return conv.to_bytes(ws);
+}
+
+/**
+ * @brief Макрос для сравнения wide strings
+ */
+#define CHECK_WIDE_EQUAL(expected, actual) \
+    CHECK_EQUAL(wideToUtf8(expected), wideToUtf8(actual))
+
+/**
+ * @brief Test Suite для тестирования составного шифра
+ */
+SUITE(ProductTest)
+{
+    /**
+     * @brief Тест совпадения с последовательными ступенями
+     * @details Короткий текст и текст длиннее порога блочного обхода
+     */
+    TEST(MatchesSequential) {
+        wstring text = L"Съешь же ещё этих мягких французских булок, да выпей чаю. ";
+        wstring longText;
+        while (longText.size() < 2 * transposeThreshold)
+            longText += text;
+        for (const wstring* t : {&text, &longText}) {
+            for (int cols : {1, 3, 16, 37}) {
+                modAlphaCipher alpha(L"КЛЮЧ");
+                Table table(cols);
+                modProductCipher product(L"КЛЮЧ", cols);
+                wstring expected = table.encrypt(alpha.encrypt(*t));
+                wstring encrypted = product.encrypt(*t);
+                CHECK(expected == encrypted);
+                CHECK(alpha.decrypt(table.decrypt(encrypted)) == product.decrypt(encrypted));
+            }
+        }
+    }
+
+    /**
+     * @brief Тест короткого сообщения
+     */
+    TEST(ShortText) {
+        modProductCipher product(L"МИР", 3);
+        wstring encrypted = product.encrypt(L"привет, мир");
+        CHECK_WIDE_EQUAL(Table(3).encrypt(modAlphaCipher(L"МИР").encrypt(L"привет, мир")), encrypted);
+        CHECK_WIDE_EQUAL(L"ПРИВЕТМИР", product.decrypt(encrypted));
+    }
+
+    /**
+     * @brief Тест цепочки ступеней над IndexedText
+     * @details Текст проверяется один раз и не переводится в wstring между ступенями
+     */
+    TEST(MatchesIndexedChain) {
+        modAlphaCipher alpha(L"КЛЮЧ");
+        Table table(5);
+        modProductCipher product(L"КЛЮЧ", 5);
+        IndexedText text = IndexedText::fromOpenText(L"Съешь же ещё этих мягких французских булок");
+        IndexedText encrypted = table.encrypt(alpha.encrypt(text));
+        CHECK_WIDE_EQUAL(product.encrypt(L"Съешь же ещё этих мягких французских булок"), encrypted.toWide());
+        CHECK(alpha.decrypt(table.decrypt(encrypted)) == text);
+    }
+
+    /**
+     * @brief Тест невалидных ключей
+     */
+    TEST(InvalidKeys) {
+        CHECK_THROW(modProductCipher(L"", 3), cipher_error);
+        CHECK_THROW(modProductCipher(L"КЛ1Ч", 3), cipher_error);
+        CHECK_THROW(modProductCipher(L"МИР", 0), cipher_error);
+    }
+
+    /**
+     * @brief Тест невалидного текста
+     */
+    TEST(InvalidText) {
+        modProductCipher product(L"МИР", 3);
+        CHECK_THROW(product.encrypt(L"123 !"), cipher_error);
+        CHECK_THROW(product.decrypt(L""), cipher_error);
+        CHECK_THROW(product.decrypt(L"ИТР РЕИ"), cipher_error);
+    }
+}
+
+/**
+ * @brief Главная функция запуска тестов
+ * @return Код завершения тестирования
+ */
+int main()
+{
+    locale::global(locale(""));
+    return UnitTest::RunAllTests();
+}
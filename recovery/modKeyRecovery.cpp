@@ -0,0 +1,316 @@
+/**
+ * @file modKeyRecovery.cpp
+ * @brief Реализация класса KeyRecovery
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include "modKeyRecovery.h"
+#include <algorithm>
+#include <unordered_map>
+#include "../common/modAlphabet.h"
+#include "../common/modNormalize.h"
+#include "../common/modParallel.h"
+
+namespace {
+
+/// Частоты русских букв в порядке алфавита
+constexpr float russianFreq[Alphabet::size] = {
+    0.0801f, 0.0159f, 0.0454f, 0.0170f, 0.0298f, 0.0845f, 0.0004f, 0.0094f,
+    0.0165f, 0.0735f, 0.0121f, 0.0349f, 0.0440f, 0.0321f, 0.0670f, 0.1097f,
+    0.0281f, 0.0473f, 0.0547f, 0.0626f, 0.0262f, 0.0026f, 0.0097f, 0.0048f,
+    0.0144f, 0.0073f, 0.0036f, 0.0004f, 0.0190f, 0.0174f, 0.0032f, 0.0064f,
+    0.0201f
+};
+
+/// Индекс совпадений русского текста
+constexpr double russianIoc = 0.0553;
+/// Индекс совпадений равномерно случайного текста
+constexpr double randomIoc = 1.0 / Alphabet::size;
+
+/// Частые биграммы русского текста
+constexpr wchar_t frequentBigrams[] =
+    L"СТ НО ТО НА ЕН ОВ НИ РА ВО КО ЕР ПО ПР ОР ЛИ ЛА АЛ РЕ ЕТ ОЛ ВА ОС ТА ОН "
+    L"ГО ЕЛ ЛЕ ЕС ТЕ НЕ ОМ АН ИН ДЕ ТИ КА МИ ОТ ОД ЛО ИЕ ЕМ ИТ ЧТ ЕВ ДА ВЕ";
+
+/**
+ * @brief Таблица частых биграмм
+ */
+struct BigramTable {
+    uint8_t hit[Alphabet::size * Alphabet::size] = {}; ///< 1 для частой биграммы
+};
+
+/**
+ * @brief Построение таблицы частых биграмм
+ * @return Таблица
+ */
+constexpr BigramTable buildBigrams() {
+    BigramTable t;
+    for (size_t i = 0; i + 2 < sizeof(frequentBigrams) / sizeof(wchar_t); i += 3) {
+        int a = Alphabet::upperIndex(frequentBigrams[i]);
+        int b = Alphabet::upperIndex(frequentBigrams[i + 1]);
+        t.hit[a * Alphabet::size + b] = 1;
+    }
+    return t;
+}
+
+constexpr BigramTable bigrams = buildBigrams();
+
+/**
+ * @brief Оценка выборки по частым биграммам
+ * @param [in] idx Номера букв
+ * @param [in] n Количество номеров
+ * @return Доля частых биграмм
+ */
+double bigramScore(const uint8_t* idx, size_t n) noexcept {
+    if (n < 2)
+        return 0;
+    unsigned hits = 0;
+    for (size_t i = 0; i + 1 < n; ++i)
+        hits += bigrams.hit[idx[i] * Alphabet::size + idx[i + 1]];
+    return static_cast<double>(hits) / (n - 1);
+}
+
+} // namespace
+
+/**
+ * @brief Проверка шифротекста и перевод выборки в номера букв
+ * @param [in] cipher_text Шифротекст
+ * @param [in] sample Наибольшая длина выборки
+ * @return Номера первых min(sample, size()) букв
+ * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+ */
+std::vector<uint8_t> KeyRecovery::toIndices(const std::wstring& cipher_text, size_t sample) {
+    if (cipher_text.empty())
+        throwCipherError("Empty cipher text");
+    const size_t size = cipher_text.size();
+    const size_t n = std::min(sample, size);
+    std::vector<uint8_t> idx(n);
+    // Выборка проверяется при переводе, остаток текста - без перевода
+    if (Normalize::upperIndices(cipher_text.data(), n, idx.data()) != n
+            || n + Normalize::findNonUpper(cipher_text.data() + n, size - n) != size)
+        throwCipherError("Invalid cipher text");
+    return idx;
+}
+
+/**
+ * @brief Средний индекс совпадений по позициям ключа
+ * @param [in] idx Номера букв
+ * @param [in] n Количество номеров
+ * @param [in] period Предполагаемая длина ключа
+ * @return Индекс совпадений
+ */
+double KeyRecovery::coincidence(const uint8_t* idx, size_t n, size_t period) noexcept {
+    // Гистограммы всех позиций ключа в одном плоском массиве
+    std::vector<uint32_t> hist(period * Alphabet::size);
+    for (size_t i = 0, r = 0; i < n; ++i) {
+        hist[r * Alphabet::size + idx[i]]++;
+        if (++r == period)
+            r = 0;
+    }
+    double sum = 0;
+    size_t used = 0;
+    for (size_t r = 0; r < period; ++r) {
+        const uint32_t* h = hist.data() + r * Alphabet::size;
+        uint64_t pairs = 0;
+        uint64_t m = 0;
+        for (int i = 0; i < Alphabet::size; ++i) {
+            uint64_t c = h[i];
+            pairs += c * (c - 1);
+            m += c;
+        }
+        if (m > 1) {
+            sum += static_cast<double>(pairs) / (m * (m - 1));
+            ++used;
+        }
+    }
+    return used ? sum / used : 0;
+}
+
+/**
+ * @brief Метод Касиски
+ * @param [in] idx Номера букв
+ * @param [in] n Количество номеров
+ * @param [in] maxPeriod Наибольшая длина ключа
+ * @return Период с наибольшим числом голосов или 1
+ */
+size_t KeyRecovery::kasiski(const uint8_t* idx, size_t n, size_t maxPeriod) {
+    std::unordered_map<uint32_t, size_t> last;
+    std::vector<size_t> votes(maxPeriod + 1);
+    for (size_t i = 0; i + 2 < n; ++i) {
+        uint32_t tri = (idx[i] * Alphabet::size + idx[i + 1]) * Alphabet::size + idx[i + 2];
+        auto it = last.find(tri);
+        if (it != last.end()) {
+            size_t d = i - it->second;
+            for (size_t p = 2; p <= maxPeriod; ++p)
+                votes[p] += d % p == 0;
+            it->second = i;
+        } else {
+            last.emplace(tri, i);
+        }
+    }
+    // Делители голосуют и за кратные, поэтому голоса взвешиваются длиной
+    size_t best = 1;
+    size_t bestScore = 0;
+    for (size_t p = 2; p <= maxPeriod; ++p) {
+        if (votes[p] * p > bestScore) {
+            bestScore = votes[p] * p;
+            best = p;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Подбор сдвига одной позиции ключа
+ * @param [in] idx Номера букв
+ * @param [in] n Количество номеров
+ * @param [in] period Длина ключа
+ * @param [in] offset Позиция в ключе
+ * @param [out] score Корреляция лучшего сдвига
+ * @return Номер буквы ключа
+ */
+int KeyRecovery::bestShift(const uint8_t* idx, size_t n, size_t period, size_t offset, double& score) noexcept {
+    // Удвоенная гистограмма: сдвиг читается без взятия по модулю
+    float hist[2 * Alphabet::size] = {};
+    size_t m = 0;
+    for (size_t i = offset; i < n; i += period, ++m)
+        hist[idx[i]] += 1;
+    std::copy(hist, hist + Alphabet::size, hist + Alphabet::size);
+    int best = 0;
+    float bestCorr = -1;
+    for (int s = 0; s < Alphabet::size; ++s) {
+        float corr = 0;
+        for (int i = 0; i < Alphabet::size; ++i)
+            corr += russianFreq[i] * hist[i + s];
+        if (corr > bestCorr) {
+            bestCorr = corr;
+            best = s;
+        }
+    }
+    score = m ? bestCorr / m : 0;
+    return best;
+}
+
+/**
+ * @brief Ранжирование количеств столбцов
+ * @param [in] cipher_text Шифротекст Table
+ * @param [in] sample Длина выборки
+ * @param [in] threads Количество потоков (0 - по числу ядер)
+ * @return Кандидаты по убыванию оценки
+ * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+ */
+std::vector<TableCandidate> KeyRecovery::rankTableKeys(const std::wstring& cipher_text, size_t sample, unsigned threads) {
+    const size_t n = cipher_text.size();
+    if (n == 0)
+        throwCipherError("Empty cipher text");
+    if (Normalize::findNonUpper(cipher_text.data(), n) != n)
+        throwCipherError("Invalid cipher text");
+    const size_t m = std::min(sample, n);
+    std::vector<TableCandidate> result(std::min<size_t>(maxCols, n));
+    parallelFor(result.size(), parallelThreads(threads), [&](size_t task) {
+        const size_t cols = task + 1;
+        const size_t rows = (n + cols - 1) / cols;
+        const size_t fullCols = n % cols == 0 ? cols : n % cols;
+        // Первые m букв открытого текста по началам столбцов
+        std::vector<uint8_t> plain(m);
+        for (size_t col = 0; col < cols && col < m; ++col) {
+            size_t start = (cols - 1 - col) * (rows - 1) + (fullCols > col + 1 ? fullCols - col - 1 : 0);
+            for (size_t i = col, row = 0; i < m; i += cols, ++row)
+                plain[i] = static_cast<uint8_t>(Alphabet::upperIndex(cipher_text[start + row]));
+        }
+        result[task].cols = static_cast<int>(cols);
+        result[task].score = bigramScore(plain.data(), m);
+    });
+    std::stable_sort(result.begin(), result.end(), [](const TableCandidate& a, const TableCandidate& b) {
+        return a.score > b.score;
+    });
+    return result;
+}
+
+/**
+ * @brief Ранжирование длин ключа шифра Гронсфельда
+ * @param [in] cipher_text Шифротекст modAlphaCipher
+ * @param [in] maxPeriod Наибольшая длина ключа
+ * @param [in] sample Длина выборки
+ * @param [in] threads Количество потоков (0 - по числу ядер)
+ * @return Кандидаты по возрастанию длины
+ * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+ */
+std::vector<PeriodCandidate> KeyRecovery::rankPeriods(const std::wstring& cipher_text,
+        size_t maxPeriod, size_t sample, unsigned threads) {
+    std::vector<uint8_t> idx = toIndices(cipher_text, sample);
+    std::vector<PeriodCandidate> result(std::max<size_t>(1, std::min(maxPeriod, idx.size())));
+    parallelFor(result.size(), parallelThreads(threads), [&](size_t task) {
+        result[task].period = task + 1;
+        result[task].ioc = coincidence(idx.data(), idx.size(), task + 1);
+    });
+    return result;
+}
+
+/**
+ * @brief Определение длины ключа шифра Гронсфельда
+ * @param [in] cipher_text Шифротекст modAlphaCipher
+ * @param [in] maxPeriod Наибольшая длина ключа
+ * @param [in] sample Длина выборки
+ * @return Длина ключа
+ * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+ */
+size_t KeyRecovery::findPeriod(const std::wstring& cipher_text, size_t maxPeriod, size_t sample) {
+    std::vector<uint8_t> idx = toIndices(cipher_text, sample);
+    return periodOf(idx.data(), idx.size(), maxPeriod);
+}
+
+/**
+ * @brief Определение длины ключа по номерам букв
+ * @param [in] idx Номера букв
+ * @param [in] n Количество номеров
+ * @param [in] maxPeriod Наибольшая длина ключа
+ * @return Длина ключа
+ */
+size_t KeyRecovery::periodOf(const uint8_t* idx, size_t n, size_t maxPeriod) {
+    maxPeriod = std::max<size_t>(1, maxPeriod);
+    const size_t limit = std::min(maxPeriod, n / minCoset);
+    std::vector<double> ioc(limit + 1);
+    double best = 0;
+    for (size_t p = 1; p <= limit; ++p) {
+        ioc[p] = coincidence(idx, n, p);
+        best = std::max(best, ioc[p]);
+    }
+    // Индекс совпадений не нашел длину, похожую на открытый текст
+    if (limit < maxPeriod && best < (russianIoc + randomIoc) / 2)
+        return kasiski(idx, n, maxPeriod);
+    for (size_t p = 1; p <= limit; ++p) {
+        if (ioc[p] >= 0.85 * best)
+            return p;
+    }
+    return 1;
+}
+
+/**
+ * @brief Подбор ключа шифра Гронсфельда
+ * @param [in] cipher_text Шифротекст modAlphaCipher
+ * @param [in] maxPeriod Наибольшая длина ключа
+ * @param [in] sample Длина выборки
+ * @param [in] threads Количество потоков (0 - по числу ядер)
+ * @return Найденный ключ
+ * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+ */
+AlphaCandidate KeyRecovery::recoverAlphaKey(const std::wstring& cipher_text,
+        size_t maxPeriod, size_t sample, unsigned threads) {
+    std::vector<uint8_t> idx = toIndices(cipher_text, sample);
+    const size_t period = periodOf(idx.data(), idx.size(), maxPeriod);
+    std::vector<int> shifts(period);
+    std::vector<double> scores(period);
+    parallelFor(period, parallelThreads(threads), [&](size_t r) {
+        shifts[r] = bestShift(idx.data(), idx.size(), period, r, scores[r]);
+    });
+    AlphaCandidate result;
+    for (size_t r = 0; r < period; ++r) {
+        result.key.push_back(Alphabet::letter(shifts[r]));
+        result.score += scores[r];
+    }
+    result.score /= period;
+    return result;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file modKeyRecovery.h
+ * @brief Заголовочный файл для класса KeyRecovery
+ * @details Подбор утерянных ключей маршрутной перестановки и шифра
+ * Гронсфельда по шифротексту
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../common/modCipherError.h"
+
+/**
+ * @brief Кандидат ключа маршрутной перестановки
+ */
+struct TableCandidate {
+    int cols = 0;       ///< Количество столбцов
+    double score = 0;   ///< Доля частых биграмм в начале расшифрованного текста
+};
+
+/**
+ * @brief Кандидат периода ключа шифра Гронсфельда
+ */
+struct PeriodCandidate {
+    size_t period = 0;  ///< Длина ключа
+    double ioc = 0;     ///< Средний индекс совпадений по позициям ключа
+};
+
+/**
+ * @brief Кандидат ключа шифра Гронсфельда
+ */
+struct AlphaCandidate {
+    std::wstring key;   ///< Ключ прописными буквами
+    double score = 0;   ///< Средняя корреляция с частотами русских букв
+};
+
+/**
+ * @brief Класс подбора ключей по шифротексту
+ * @details Шифротекст проверяется и переводится в номера букв один раз;
+ * кандидаты оцениваются по выборке из начала текста без расшифрования
+ * всего архива. Гистограммы всех позиций ключа хранятся в одном плоском
+ * массиве
+ */
+class KeyRecovery {
+private:
+    /**
+     * @brief Проверка шифротекста и перевод выборки в номера букв
+     * @details Проверяется весь текст, в номера переводится только выборка
+     * @param [in] cipher_text Шифротекст
+     * @param [in] sample Наибольшая длина выборки
+     * @return Номера первых min(sample, size()) букв
+     * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+     */
+    static std::vector<uint8_t> toIndices(const std::wstring& cipher_text, size_t sample);
+
+    /**
+     * @brief Средний индекс совпадений по позициям ключа
+     * @param [in] idx Номера букв
+     * @param [in] n Количество номеров
+     * @param [in] period Предполагаемая длина ключа
+     * @return Индекс совпадений
+     */
+    static double coincidence(const uint8_t* idx, size_t n, size_t period) noexcept;
+
+    /**
+     * @brief Метод Касиски
+     * @details Голосование расстояний между повторами триграмм за
+     * делители от 2 до maxPeriod
+     * @param [in] idx Номера букв
+     * @param [in] n Количество номеров
+     * @param [in] maxPeriod Наибольшая длина ключа
+     * @return Период с наибольшим числом голосов или 1
+     */
+    static size_t kasiski(const uint8_t* idx, size_t n, size_t maxPeriod);
+
+    /**
+     * @brief Подбор сдвига одной позиции ключа
+     * @param [in] idx Номера букв
+     * @param [in] n Количество номеров
+     * @param [in] period Длина ключа
+     * @param [in] offset Позиция в ключе
+     * @param [out] score Корреляция лучшего сдвига
+     * @return Номер буквы ключа
+     */
+    static int bestShift(const uint8_t* idx, size_t n, size_t period, size_t offset, double& score) noexcept;
+
+    /**
+     * @brief Определение длины ключа по номерам букв
+     * @param [in] idx Номера букв
+     * @param [in] n Количество номеров
+     * @param [in] maxPeriod Наибольшая длина ключа
+     * @return Длина ключа
+     */
+    static size_t periodOf(const uint8_t* idx, size_t n, size_t maxPeriod);
+
+public:
+    /// Наибольшее перебираемое количество столбцов, как Table::defaultMaxKey
+    static constexpr int maxCols = 100;
+    /// Длина выборки по умолчанию для перестановки
+    static constexpr size_t defaultTableSample = 4096;
+    /// Длина выборки по умолчанию для шифра Гронсфельда
+    static constexpr size_t defaultAlphaSample = 1 << 16;
+    /// Наибольшая длина ключа по умолчанию
+    static constexpr size_t defaultMaxPeriod = 64;
+    /// Наименьшее число букв на позицию ключа для индекса совпадений
+    static constexpr size_t minCoset = 40;
+
+    /**
+     * @brief Ранжирование количеств столбцов
+     * @details Все количества от 1 до min(maxCols, size()) оцениваются
+     * параллельно. Весь текст только проверяется, а номера вычисляются
+     * лишь для первых sample букв открытого текста, прочитанных по
+     * началам столбцов шифротекста
+     * @param [in] cipher_text Шифротекст Table
+     * @param [in] sample Длина выборки
+     * @param [in] threads Количество потоков (0 - по числу ядер)
+     * @return Кандидаты по убыванию оценки
+     * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+     */
+    static std::vector<TableCandidate> rankTableKeys(const std::wstring& cipher_text,
+            size_t sample = defaultTableSample, unsigned threads = 0);
+
+    /**
+     * @brief Ранжирование длин ключа шифра Гронсфельда
+     * @details Для каждой длины считается средний индекс совпадений
+     * по позициям ключа
+     * @param [in] cipher_text Шифротекст modAlphaCipher
+     * @param [in] maxPeriod Наибольшая длина ключа
+     * @param [in] sample Длина выборки
+     * @param [in] threads Количество потоков (0 - по числу ядер)
+     * @return Кандидаты по возрастанию длины
+     * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+     */
+    static std::vector<PeriodCandidate> rankPeriods(const std::wstring& cipher_text,
+            size_t maxPeriod = defaultMaxPeriod, size_t sample = defaultAlphaSample, unsigned threads = 0);
+
+    /**
+     * @brief Определение длины ключа шифра Гронсфельда
+     * @details Выбирается наименьшая длина, индекс совпадений которой не
+     * ниже 0.85 от наибольшего: кратные длины дают такой же индекс. Если
+     * выборка слишком коротка для индекса совпадений, используется метод
+     * Касиски
+     * @param [in] cipher_text Шифротекст modAlphaCipher
+     * @param [in] maxPeriod Наибольшая длина ключа
+     * @param [in] sample Длина выборки
+     * @return Длина ключа
+     * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+     */
+    static size_t findPeriod(const std::wstring& cipher_text,
+            size_t maxPeriod = defaultMaxPeriod, size_t sample = defaultAlphaSample);
+
+    /**
+     * @brief Подбор ключа шифра Гронсфельда
+     * @details Длина ключа определяется findPeriod(), затем каждая позиция
+     * ключа подбирается параллельно по корреляции гистограммы с частотами
+     * русских букв
+     * @param [in] cipher_text Шифротекст modAlphaCipher
+     * @param [in] maxPeriod Наибольшая длина ключа
+     * @param [in] sample Длина выборки
+     * @param [in] threads Количество потоков (0 - по числу ядер)
+     * @return Найденный ключ
+     * @throw cipher_error Если текст пустой или содержит не-прописные буквы
+     */
+    static AlphaCandidate recoverAlphaKey(const std::wstring& cipher_text,
+            size_t maxPeriod = defaultMaxPeriod, size_t sample = defaultAlphaSample, unsigned threads = 0);
+};
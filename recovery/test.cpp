@@ -0,0 +1,156 @@
+/**
+ * @file test.cpp
+ * @brief Модульные тесты для класса KeyRecovery
+ * @details Шифрует русский текст известными ключами и проверяет, что
+ * ключи восстанавливаются по шифротексту
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include <UnitTest++/UnitTest++.h>
+#include <string>
+#include <locale>
+#include <codecvt>
+#include "modKeyRecovery.h"
+#include "../2.1/modAlphaCipher.h"
+#include "../2.2/modTableCipher.h"
+
+using namespace std;
+
+/**
+ * @brief Преобразование wide string в UTF-8 string
+ * @param [in] ws Строка в формате wstring
+ * @return Строка в формате UTF-8
+ */
+string wideToUtf8(const wstring& ws) {
+    wstring_convert<codecvt_utf8<wchar_t>> conv;
+    return conv.to_bytes(ws);
+}
+
+/**
+ * @brief Макрос для сравнения wide strings
+ */
+#define CHECK_WIDE_EQUAL(expected, actual) \
+    CHECK_EQUAL(wideToUtf8(expected), wideToUtf8(actual))
+
+/**
+ * @brief Русский текст для подбора ключей
+ */
+const wstring prose =
+    L"Старый дом стоял на краю деревни, у самой реки. Летом в нем жили дети, "
+    L"которые приезжали из города к бабушке, а зимой окна закрывали ставнями, "
+    L"и только дым из трубы говорил соседям, что хозяйка еще не уехала. "
+    L"По утрам она выходила на крыльцо, смотрела на дорогу и долго ждала почту. "
+    L"Писем приходило немного, но каждое она читала вслух, медленно и громко, "
+    L"словно хотела, чтобы его услышали и старые яблони в саду, и собака у ворот. "
+    L"Вечером она садилась у печи, вязала носки для внуков и вспоминала время, "
+    L"когда дом был полон людей, а на столе не хватало места для пирогов. "
+    L"Тогда отец работал на мельнице, мать пекла хлеб, а младшие братья бегали "
+    L"к реке ловить рыбу и возвращались только к ночи, мокрые и счастливые. "
+    L"Теперь мельница давно разрушилась, братья разъехались по разным городам, "
+    L"и лишь весной, когда распускались листья, в доме снова звучали голоса. "
+    L"Внуки привозили новости, рассказывали об учебе и друзьях, спорили о книгах "
+    L"и каждый раз обещали приехать на все лето, хотя знали, что не смогут. "
+    L"Бабушка не обижалась. Она понимала, что у молодых своя жизнь, свои заботы "
+    L"и свои дороги, и радовалась уже тому, что они помнят про старый дом.";
+
+/**
+ * @brief Test Suite для подбора количества столбцов
+ */
+SUITE(TableRecoveryTest)
+{
+    /**
+     * @brief Тест восстановления количества столбцов
+     * @details Проверяет короткую и полную выборку и несколько потоков
+     */
+    TEST(FindsCols) {
+        for (int cols : {2, 5, 7, 16, 33}) {
+            wstring cipher = Table(cols).encrypt(prose);
+            CHECK_EQUAL(cols, KeyRecovery::rankTableKeys(cipher).front().cols);
+            CHECK_EQUAL(cols, KeyRecovery::rankTableKeys(cipher, 400, 4).front().cols);
+        }
+    }
+
+    /**
+     * @brief Тест количества кандидатов
+     * @details Кандидатов не больше длины текста
+     */
+    TEST(CandidateCount) {
+        CHECK_EQUAL(static_cast<size_t>(KeyRecovery::maxCols),
+                    KeyRecovery::rankTableKeys(Table(3).encrypt(prose)).size());
+        CHECK_EQUAL(3u, KeyRecovery::rankTableKeys(L"АБВ").size());
+    }
+
+    /**
+     * @brief Тест невалидного шифротекста
+     * @details Ошибка за пределами выборки тоже обнаруживается
+     */
+    TEST(InvalidText) {
+        CHECK_THROW(KeyRecovery::rankTableKeys(L""), cipher_error);
+        CHECK_THROW(KeyRecovery::rankTableKeys(L"ИТР РЕИ"), cipher_error);
+        CHECK_THROW(KeyRecovery::rankTableKeys(Table(3).encrypt(prose) + L"я", 100), cipher_error);
+    }
+}
+
+/**
+ * @brief Test Suite для подбора ключа шифра Гронсфельда
+ */
+SUITE(AlphaRecoveryTest)
+{
+    /**
+     * @brief Тест определения длины ключа
+     */
+    TEST(FindsPeriod) {
+        CHECK_EQUAL(1u, KeyRecovery::findPeriod(modAlphaCipher(L"Я").encrypt(prose)));
+        CHECK_EQUAL(4u, KeyRecovery::findPeriod(modAlphaCipher(L"КЛЮЧ").encrypt(prose)));
+        CHECK_EQUAL(7u, KeyRecovery::findPeriod(modAlphaCipher(L"ПАРОЛЬЕ").encrypt(prose)));
+    }
+
+    /**
+     * @brief Тест ранжирования длин ключа
+     * @details Индекс совпадений истинной длины выше, чем у соседних
+     */
+    TEST(RankPeriods) {
+        auto periods = KeyRecovery::rankPeriods(modAlphaCipher(L"КЛЮЧ").encrypt(prose), 8);
+        CHECK_EQUAL(8u, periods.size());
+        CHECK_EQUAL(4u, periods[3].period);
+        CHECK(periods[3].ioc > periods[2].ioc);
+        CHECK(periods[3].ioc > periods[4].ioc);
+    }
+
+    /**
+     * @brief Тест восстановления ключа
+     */
+    TEST(RecoversKey) {
+        for (const wchar_t* key : {L"КЛЮЧ", L"МИР", L"ПАРОЛЬЕ"}) {
+            wstring cipher = modAlphaCipher(key).encrypt(prose);
+            AlphaCandidate found = KeyRecovery::recoverAlphaKey(cipher);
+            CHECK_WIDE_EQUAL(key, found.key);
+            CHECK_WIDE_EQUAL(modAlphaCipher(key).decrypt(cipher), modAlphaCipher(found.key).decrypt(cipher));
+        }
+    }
+
+    /**
+     * @brief Тест невалидного шифротекста
+     * @details Ошибка за пределами выборки тоже обнаруживается
+     */
+    TEST(InvalidText) {
+        CHECK_THROW(KeyRecovery::recoverAlphaKey(L""), cipher_error);
+        CHECK_THROW(KeyRecovery::findPeriod(L"МИРмир"), cipher_error);
+        wstring tail = modAlphaCipher(L"МИР").encrypt(prose) + L"я";
+        CHECK_THROW(KeyRecovery::rankPeriods(tail, 8, 100), cipher_error);
+        CHECK_THROW(KeyRecovery::findPeriod(tail, 8, 100), cipher_error);
+        CHECK_THROW(KeyRecovery::recoverAlphaKey(tail, 8, 100), cipher_error);
+    }
+}
+
+/**
+ * @brief Главная функция запуска тестов
+ * @return Код завершения тестирования
+ */
+int main()
+{
+    locale::global(locale(""));
+    return UnitTest::RunAllTests();
+}
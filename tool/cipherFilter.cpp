@@ -0,0 +1,470 @@
+/**
+ * @file cipherFilter.cpp
+ * @brief Конвейерный фильтр stdin -> stdout для шифра Гронсфельда
+ * @details Поток чтения заполняет буферы фрагментами текста в UTF-8,
+ * потоки преобразования шифруют их modAlphaStream с позиции в ключе,
+ * равной числу букв предыдущих фрагментов, поток записи выводит
+ * результаты по порядку. Буферы передаются между потоками через
+ * ограниченные очереди без блокировок; буферов 2 * ПОТОКИ + 1, поэтому
+ * чтение, преобразование и запись перекрываются. Поток без работы после
+ * короткого ожидания засыпает на условной переменной и не занимает
+ * процессор, пока вход простаивает. По завершении выводится
+ * пропускная способность.
+ *
+ * Использование:
+ * @code
+ * cipherFilter -a КЛЮЧ (-e|-d) [-j ПОТОКИ] [-b БАЙТЫ] < ВХОД > ВЫХОД
+ * @endcode
+ *
+ * Сборка:
+ * @code
+ * g++ -std=c++17 -O2 -pthread tool/cipherFilter.cpp 2.1/modAlphaCipher.cpp 2.1/modAlphaStream.cpp \
+ *     2.1/modKeySchedule.cpp 2.1/modShiftKernel.cpp -o cipherFilter
+ * @endcode
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "../2.1/modAlphaStream.h"
+#include "../common/modParallel.h"
+#include "modKeyArg.h"
+
+using namespace std;
+
+/**
+ * @brief Ограниченная очередь без блокировок для нескольких производителей и потребителей
+ * @details Кольцевой буфер с номером поколения в каждой ячейке: ячейка
+ * свободна для записи, когда ее номер равен позиции записи, и готова для
+ * чтения, когда он на единицу больше позиции чтения
+ */
+template <class T>
+class BoundedQueue {
+private:
+    /**
+     * @brief Ячейка очереди
+     */
+    struct Cell {
+        atomic<size_t> seq; /// Номер поколения ячейки
+        T value;            /// Значение
+    };
+
+    unique_ptr<Cell[]> cells;         /// Ячейки
+    size_t mask;                      /// Емкость минус один
+    alignas(64) atomic<size_t> head;  /// Позиция записи
+    alignas(64) atomic<size_t> tail;  /// Позиция чтения
+
+public:
+    /**
+     * @brief Создание очереди
+     * @param [in] capacity Наименьшая емкость; округляется до степени двойки
+     */
+    explicit BoundedQueue(size_t capacity) : head(0), tail(0) {
+        size_t size = 1;
+        while (size < capacity)
+            size <<= 1;
+        cells.reset(new Cell[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; ++i)
+            cells[i].seq.store(i, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Попытка добавить значение
+     * @param [in] v Значение
+     * @return false, если очередь заполнена
+     */
+    bool tryPush(const T& v) {
+        size_t pos = head.load(memory_order_relaxed);
+        for (;;) {
+            Cell& c = cells[pos & mask];
+            size_t s = c.seq.load(memory_order_acquire);
+            intptr_t d = static_cast<intptr_t>(s) - static_cast<intptr_t>(pos);
+            if (d == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    c.value = v;
+                    c.seq.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if (d < 0) {
+                return false;
+            } else {
+                pos = head.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Попытка извлечь значение
+     * @param [out] v Значение
+     * @return false, если очередь пуста
+     */
+    bool tryPop(T& v) {
+        size_t pos = tail.load(memory_order_relaxed);
+        for (;;) {
+            Cell& c = cells[pos & mask];
+            size_t s = c.seq.load(memory_order_acquire);
+            intptr_t d = static_cast<intptr_t>(s) - static_cast<intptr_t>(pos + 1);
+            if (d == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    v = c.value;
+                    c.seq.store(pos + mask + 1, memory_order_release);
+                    return true;
+                }
+            } else if (d < 0) {
+                return false;
+            } else {
+                pos = tail.load(memory_order_relaxed);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Фрагмент текста в конвейере
+ */
+struct Chunk {
+    string in;          ///< Входные байты
+    size_t inLen = 0;   ///< Длина входа
+    string out;         ///< Буфер результата
+    size_t outLen = 0;  ///< Длина результата
+    size_t seq = 0;     ///< Номер фрагмента
+};
+
+/**
+ * @brief Конвейер чтения, преобразования и записи
+ */
+class Pipeline {
+private:
+    /// Признак конца работы в очереди фрагментов
+    static constexpr size_t stop = SIZE_MAX;
+    /// Количество проверок условия перед засыпанием
+    static constexpr int spinLimit = 64;
+
+    const modAlphaCipher& cipher;  /// Шифратор с ключом
+    modAlphaStream::Mode mode;     /// Направление преобразования
+    unsigned workers;              /// Количество потоков преобразования
+    size_t chunkSize;              /// Размер фрагмента в байтах
+    vector<Chunk> chunks;          /// Буферы фрагментов
+    BoundedQueue<size_t> freeSlots; /// Свободные буферы
+    BoundedQueue<size_t> work;     /// Прочитанные фрагменты
+    BoundedQueue<size_t> done;     /// Преобразованные фрагменты
+
+    atomic<size_t> total{stop};    /// Количество фрагментов, известно после конца входа
+    atomic<size_t> published{0};   /// Число фрагментов с известной позицией в ключе
+    size_t nextLetter = 0;         /// Букв перед фрагментом published
+    atomic<bool> failed{false};    /// Признак ошибки в любом потоке
+    mutex errorLock;               /// Защита error
+    exception_ptr error;           /// Первая ошибка
+    mutex parkLock;                /// Защита засыпания потоков
+    condition_variable parked;     /// Пробуждение спящих потоков
+    atomic<unsigned> sleepers{0};  /// Количество спящих или засыпающих потоков
+
+public:
+    size_t bytesIn = 0;   ///< Прочитано байтов
+    size_t bytesOut = 0;  ///< Записано байтов
+
+    /**
+     * @brief Создание конвейера
+     * @param [in] c Шифратор с ключом
+     * @param [in] m Направление преобразования
+     * @param [in] threads Количество потоков преобразования
+     * @param [in] size Размер фрагмента в байтах
+     */
+    Pipeline(const modAlphaCipher& c, modAlphaStream::Mode m, unsigned threads, size_t size)
+        : cipher(c), mode(m), workers(threads), chunkSize(size), chunks(2 * threads + 1),
+          freeSlots(chunks.size()), work(chunks.size() + threads), done(chunks.size()) {
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            chunks[i].in.resize(chunkSize + 4);
+            chunks[i].out.resize(chunkSize + 4);
+            freeSlots.tryPush(i);
+        }
+    }
+
+    /**
+     * @brief Запуск конвейера до конца входа
+     * @return Количество букв в тексте
+     * @throw cipher_error Если текст невалиден
+     * @throw runtime_error При ошибке ввода-вывода
+     */
+    size_t run() {
+        vector<thread> pool;
+        pool.emplace_back([this] { guarded([this] { reader(); }); });
+        for (unsigned i = 0; i < workers; ++i)
+            pool.emplace_back([this] { guarded([this] { transform(); }); });
+        pool.emplace_back([this] { guarded([this] { writer(); }); });
+        for (auto& t : pool)
+            t.join();
+        if (error)
+            rethrow_exception(error);
+        return nextLetter;
+    }
+
+private:
+    /**
+     * @brief Выполнение потока с перехватом ошибки
+     * @param [in] f Тело потока
+     */
+    template <class F>
+    void guarded(F f) {
+        try {
+            f();
+        } catch (...) {
+            lock_guard<mutex> guard(errorLock);
+            if (!error)
+                error = current_exception();
+            failed.store(true, memory_order_release);
+            wake();
+        }
+    }
+
+    /**
+     * @brief Пробуждение спящих потоков после изменения состояния
+     * @details Барьер парный барьеру в waitFor(): либо ожидающий поток
+     * увидит изменение, либо здесь будет виден его счетчик
+     */
+    void wake() {
+        atomic_thread_fence(memory_order_seq_cst);
+        if (sleepers.load(memory_order_relaxed) != 0) {
+            lock_guard<mutex> guard(parkLock);
+            parked.notify_all();
+        }
+    }
+
+    /**
+     * @brief Ожидание условия
+     * @details Условие проверяется spinLimit раз с уступкой процессора,
+     * затем поток засыпает до вызова wake()
+     * @param [in] f Условие
+     * @return false, если конвейер остановлен ошибкой
+     */
+    template <class F>
+    bool waitFor(F f) {
+        for (int spin = 0; spin < spinLimit; ++spin) {
+            if (f())
+                return true;
+            if (failed.load(memory_order_acquire))
+                return false;
+            this_thread::yield();
+        }
+        unique_lock<mutex> guard(parkLock);
+        sleepers.fetch_add(1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        bool ok;
+        for (;;) {
+            if (f()) {
+                ok = true;
+                break;
+            }
+            if (failed.load(memory_order_acquire)) {
+                ok = false;
+                break;
+            }
+            parked.wait(guard);
+        }
+        sleepers.fetch_sub(1, memory_order_relaxed);
+        return ok;
+    }
+
+    /**
+     * @brief Поток чтения
+     * @details Фрагмент обрезается по границе символа UTF-8, остаток
+     * переносится в начало следующего фрагмента
+     */
+    void reader() {
+        size_t seq = 0;
+        string carry;
+        bool eof = false;
+        while (!eof) {
+            size_t slot;
+            if (!waitFor([&] { return freeSlots.tryPop(slot); }))
+                return;
+            Chunk& c = chunks[slot];
+            memcpy(&c.in[0], carry.data(), carry.size());
+            size_t filled = carry.size();
+            while (filled < chunkSize) {
+                ssize_t r = ::read(STDIN_FILENO, &c.in[filled], chunkSize - filled);
+                if (r < 0 && errno == EINTR)
+                    continue;
+                if (r < 0)
+                    throw runtime_error(string("Read failed: ") + strerror(errno));
+                if (r == 0) {
+                    eof = true;
+                    break;
+                }
+                filled += static_cast<size_t>(r);
+            }
+            bytesIn += filled - carry.size();
+            size_t cut = filled;
+            if (!eof) {
+                // Начало последнего символа, если он не поместился целиком
+                size_t lead = filled;
+                while (lead > 0 && filled - lead < 4 && (static_cast<unsigned char>(c.in[lead - 1]) & 0xC0) == 0x80)
+                    --lead;
+                if (lead > 0 && static_cast<size_t>(Alphabet::utf8Length(c.in[lead - 1])) > filled - lead + 1)
+                    cut = lead - 1;
+            }
+            carry.assign(c.in.data() + cut, filled - cut);
+            c.inLen = cut;
+            c.seq = seq++;
+            work.tryPush(slot);
+            wake();
+        }
+        total.store(seq, memory_order_release);
+        for (unsigned i = 0; i < workers; ++i)
+            work.tryPush(stop);
+        wake();
+    }
+
+    /**
+     * @brief Поток преобразования
+     * @details Число букв фрагмента считается до ожидания предыдущих
+     * фрагментов, поэтому последовательной остается только передача
+     * позиции в ключе
+     */
+    void transform() {
+        modAlphaStream stream(cipher, mode);
+        for (;;) {
+            size_t slot;
+            if (!waitFor([&] { return work.tryPop(slot); }) || slot == stop)
+                return;
+            Chunk& c = chunks[slot];
+            string_view in(c.in.data(), c.inLen);
+            size_t letters = mode == modAlphaStream::Mode::Encrypt ? modAlphaStream::countLetters(in) : in.size() / 2;
+            if (!waitFor([&] { return published.load(memory_order_acquire) == c.seq; }))
+                return;
+            size_t offset = nextLetter;
+            nextLetter += letters;
+            published.store(c.seq + 1, memory_order_release);
+            wake();
+            stream.seek(offset);
+            c.outLen = stream.update(in, &c.out[0], c.out.size());
+            done.tryPush(slot);
+            wake();
+        }
+    }
+
+    /**
+     * @brief Поток записи
+     * @details Фрагменты выводятся в порядке номеров, буферы возвращаются
+     * потоку чтения в том же порядке
+     */
+    void writer() {
+        vector<size_t> pending(chunks.size(), stop);
+        size_t next = 0;
+        for (;;) {
+            size_t slot;
+            bool got = false;
+            if (!waitFor([&] { return (got = done.tryPop(slot)) || next == total.load(memory_order_acquire); }))
+                return;
+            if (!got)
+                break;
+            pending[chunks[slot].seq % chunks.size()] = slot;
+            while (pending[next % chunks.size()] != stop) {
+                size_t ready = pending[next % chunks.size()];
+                pending[next % chunks.size()] = stop;
+                Chunk& c = chunks[ready];
+                writeAll(c.out.data(), c.outLen);
+                bytesOut += c.outLen;
+                freeSlots.tryPush(ready);
+                wake();
+                ++next;
+            }
+        }
+    }
+
+    /**
+     * @brief Запись блока в stdout
+     * @param [in] buf Данные
+     * @param [in] size Размер данных
+     * @throw runtime_error При ошибке записи
+     */
+    static void writeAll(const char* buf, size_t size) {
+        while (size > 0) {
+            ssize_t w = ::write(STDOUT_FILENO, buf, size);
+            if (w < 0 && errno == EINTR)
+                continue;
+            if (w < 0)
+                throw runtime_error(string("Write failed: ") + strerror(errno));
+            buf += w;
+            size -= static_cast<size_t>(w);
+        }
+    }
+};
+
+/**
+ * @brief Вывод справки по использованию
+ * @param [in] program Имя программы
+ */
+void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s -a KEY (-e|-d) [-j THREADS] [-b BYTES] < INPUT > OUTPUT\n"
+            "  -a KEY      Gronsfeld cipher with a Russian letter key\n"
+            "  -e / -d     encrypt / decrypt\n"
+            "  -j THREADS  transform threads (default 2, 0 - all cores)\n"
+            "  -b BYTES    chunk size (default 1 MiB)\n",
+            program);
+}
+
+/**
+ * @brief Главная функция фильтра
+ * @param [in] argc Количество аргументов
+ * @param [in] argv Аргументы командной строки
+ * @return 0 при успехе, 1 при ошибке шифрования или ввода-вывода, 2 при неверных аргументах
+ */
+int main(int argc, char** argv) {
+    if (argc < 4 || argc % 2 != 0 || strcmp(argv[1], "-a") != 0
+        || (strcmp(argv[3], "-e") != 0 && strcmp(argv[3], "-d") != 0)) {
+        usage(argv[0]);
+        return 2;
+    }
+    const bool encrypt = strcmp(argv[3], "-e") == 0;
+    unsigned threads = 2;
+    size_t chunkSize = size_t(1) << 20;
+    for (int i = 4; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-j") == 0) {
+            threads = parallelThreads(static_cast<unsigned>(stoul(argv[i + 1])));
+        } else if (strcmp(argv[i], "-b") == 0) {
+            chunkSize = max<size_t>(16, stoull(argv[i + 1]));
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    try {
+        auto start = chrono::steady_clock::now();
+        modAlphaCipher cipher(keyFromUtf8(argv[2]));
+        Pipeline pipeline(cipher, encrypt ? modAlphaStream::Mode::Encrypt : modAlphaStream::Mode::Decrypt,
+                          threads, chunkSize);
+        size_t letters = pipeline.run();
+        // Как и modAlphaCipher, текст без букв считается ошибкой
+        if (letters == 0)
+            throwCipherError(encrypt ? "Empty text, no letters" : "Empty cipher text");
+
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        fprintf(stderr, "%zu bytes in, %zu bytes out, %.3f s, %.1f MB/s\n",
+                pipeline.bytesIn, pipeline.bytesOut, seconds,
+                seconds > 0 ? pipeline.bytesIn / seconds / 1e6 : 0.0);
+    } catch (const exception& e) {
+        fprintf(stderr, "Error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
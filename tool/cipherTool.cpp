@@ -0,0 +1,276 @@
+/**
+ * @file cipherTool.cpp
+ * @brief Утилита шифрования файлов шифром Гронсфельда или маршрутной перестановкой
+ * @details Входной файл в UTF-8 отображается в память, результат пишется
+ * в заранее выделенный отображенный файл (шифр Гронсфельда) или крупными
+ * блоками (перестановка). Результат пишется во временный файл рядом с
+ * выходным и переименовывается в него только при успехе, поэтому ошибка
+ * шифрования не портит существующий выходной файл. Вход и выход не могут
+ * быть одним файлом. По завершении выводится пропускная способность.
+ *
+ * Использование:
+ * @code
+ * cipherTool -a КЛЮЧ (-e|-d) ВХОД ВЫХОД
+ * cipherTool -t СТОЛБЦЫ (-e|-d) ВХОД ВЫХОД
+ * @endcode
+ *
+ * Сборка:
+ * @code
+ * g++ -std=c++17 -O2 -pthread tool/cipherTool.cpp 2.1/modAlphaCipher.cpp 2.1/modKeySchedule.cpp 2.1/modShiftKernel.cpp \
+ *     2.2/modTableCipher.cpp 2.2/modTablePlan.cpp 2.2/modTranspose.cpp -o cipherTool
+ * @endcode
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../2.1/modAlphaCipher.h"
+#include "../2.2/modTableCipher.h"
+#include "modKeyArg.h"
+
+using namespace std;
+
+/**
+ * @brief Файл, отображенный в память
+ * @details Освобождает отображение и дескриптор при разрушении
+ */
+class MappedFile {
+private:
+    int fd = -1;          /// Дескриптор файла
+    char* data = nullptr; /// Начало отображения
+    size_t length = 0;    /// Размер отображения
+    string temp;          /// Временный файл результата (пусто для входного файла)
+    string target;        /// Путь, в который переименовывается результат
+
+public:
+    /**
+     * @brief Отображение существующего файла для чтения
+     * @param [in] path Путь к файлу
+     * @throw runtime_error Если файл не удалось открыть или отобразить
+     */
+    explicit MappedFile(const char* path) {
+        fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+            throw runtime_error(string("Cannot open ") + path + ": " + strerror(errno));
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+            throw runtime_error(string("Cannot stat ") + path + ": " + strerror(errno));
+        map(static_cast<size_t>(st.st_size), PROT_READ);
+        if (data)
+            madvise(data, length, MADV_SEQUENTIAL);
+    }
+
+    /**
+     * @brief Создание временного файла результата и отображение для записи
+     * @details Файл создается рядом с path и заменяет его только в commit();
+     * без commit() временный файл удаляется
+     * @param [in] path Путь к выходному файлу
+     * @param [in] size Размер файла
+     * @throw runtime_error Если файл не удалось создать или отобразить
+     */
+    MappedFile(const char* path, size_t size) : temp(string(path) + ".XXXXXX"), target(path) {
+        fd = mkstemp(&temp[0]);
+        if (fd < 0) {
+            temp.clear();
+            throw runtime_error(string("Cannot create ") + path + ": " + strerror(errno));
+        }
+        // mkstemp создает файл с правами 0600, выход получает обычные права
+        mode_t mask = umask(0);
+        umask(mask);
+        if (fchmod(fd, 0644 & ~mask) != 0 || ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            int err = errno;
+            release();
+            throw runtime_error(string("Cannot resize ") + path + ": " + strerror(err));
+        }
+        try {
+            map(size, PROT_READ | PROT_WRITE);
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Освобождение отображения и дескриптора
+     * @details Временный файл без commit() удаляется
+     */
+    ~MappedFile() {
+        release();
+    }
+
+    /**
+     * @brief Проверка, что path - тот же файл, что и отображенный
+     * @param [in] path Путь к файлу
+     * @return true, если path ссылается на этот файл
+     */
+    bool sameFile(const char* path) const {
+        struct stat mine, other;
+        return fstat(fd, &mine) == 0 && ::stat(path, &other) == 0
+            && mine.st_dev == other.st_dev && mine.st_ino == other.st_ino;
+    }
+
+    /**
+     * @brief Замена выходного файла записанным результатом
+     * @throw runtime_error Если файл не удалось переименовать
+     */
+    void commit() {
+        if (::rename(temp.c_str(), target.c_str()) != 0)
+            throw runtime_error("Cannot rename " + temp + " to " + target + ": " + strerror(errno));
+        temp.clear();
+    }
+
+    /**
+     * @brief Содержимое файла
+     * @return Указатель на начало отображения (nullptr для пустого файла)
+     */
+    char* begin() const { return data; }
+
+    /**
+     * @brief Размер отображения
+     * @return Размер в байтах
+     */
+    size_t size() const { return length; }
+
+    /**
+     * @brief Обрезка файла до фактического размера результата
+     * @param [in] size Новый размер файла
+     * @throw runtime_error Если размер не удалось изменить
+     */
+    void truncate(size_t size) {
+        if (data) {
+            munmap(data, length);
+            data = nullptr;
+        }
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+            throw runtime_error(string("Cannot resize output: ") + strerror(errno));
+        length = size;
+    }
+
+    /**
+     * @brief Запись блока в конец файла
+     * @param [in] buf Данные
+     * @param [in] size Размер данных
+     * @throw runtime_error При ошибке записи
+     */
+    void write(const char* buf, size_t size) {
+        while (size > 0) {
+            ssize_t w = ::write(fd, buf, size);
+            if (w < 0)
+                throw runtime_error(string("Write failed: ") + strerror(errno));
+            buf += w;
+            size -= static_cast<size_t>(w);
+        }
+    }
+
+private:
+    /**
+     * @brief Освобождение отображения, дескриптора и временного файла
+     */
+    void release() noexcept {
+        if (data)
+            munmap(data, length);
+        data = nullptr;
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+        if (!temp.empty())
+            ::unlink(temp.c_str());
+        temp.clear();
+    }
+
+    /**
+     * @brief Отображение дескриптора в память
+     * @param [in] size Размер отображения
+     * @param [in] prot Права доступа
+     */
+    void map(size_t size, int prot) {
+        length = size;
+        if (size == 0)
+            return;
+        void* p = mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED)
+            throw runtime_error(string("mmap failed: ") + strerror(errno));
+        data = static_cast<char*>(p);
+    }
+};
+
+/**
+ * @brief Вывод справки по использованию
+ * @param [in] program Имя программы
+ */
+void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s -a KEY (-e|-d) INPUT OUTPUT\n"
+            "       %s -t COLS (-e|-d) INPUT OUTPUT\n"
+            "  -a KEY   Gronsfeld cipher with a Russian letter key\n"
+            "  -t COLS  route transposition with COLS columns\n"
+            "  -e / -d  encrypt / decrypt\n",
+            program, program);
+}
+
+/**
+ * @brief Главная функция утилиты
+ * @param [in] argc Количество аргументов
+ * @param [in] argv Аргументы командной строки
+ * @return 0 при успехе, 1 при ошибке шифрования или ввода-вывода, 2 при неверных аргументах
+ */
+int main(int argc, char** argv) {
+    if (argc != 6 || (strcmp(argv[1], "-a") != 0 && strcmp(argv[1], "-t") != 0)
+        || (strcmp(argv[3], "-e") != 0 && strcmp(argv[3], "-d") != 0)) {
+        usage(argv[0]);
+        return 2;
+    }
+    const bool alpha = strcmp(argv[1], "-a") == 0;
+    const bool encrypt = strcmp(argv[3], "-e") == 0;
+
+    try {
+        auto start = chrono::steady_clock::now();
+        MappedFile input(argv[4]);
+        if (input.sameFile(argv[5]))
+            throw runtime_error("Input and output are the same file");
+        string_view text(input.begin() ? input.begin() : "", input.size());
+        size_t written;
+
+        if (alpha) {
+            // Результат не длиннее входа: каждая буква - два байта на входе и на выходе
+            modAlphaCipher cipher(keyFromUtf8(argv[2]));
+            MappedFile output(argv[5], text.size());
+            written = encrypt ? cipher.encryptInto(text, output.begin(), output.size())
+                              : cipher.decryptInto(text, output.begin(), output.size());
+            output.truncate(written);
+            output.commit();
+        } else {
+            Table cipher(stoi(argv[2]));
+            string result = encrypt ? cipher.encrypt(text) : cipher.decrypt(text);
+            MappedFile output(argv[5], 0);
+            const size_t chunk = size_t(1) << 24;
+            for (size_t pos = 0; pos < result.size(); pos += chunk)
+                output.write(result.data() + pos, min(chunk, result.size() - pos));
+            output.commit();
+            written = result.size();
+        }
+
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        fprintf(stderr, "%zu bytes in, %zu bytes out, %.3f s, %.1f MB/s\n",
+                text.size(), written, seconds, seconds > 0 ? text.size() / seconds / 1e6 : 0.0);
+    } catch (const exception& e) {
+        fprintf(stderr, "Error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
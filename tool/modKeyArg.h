@@ -0,0 +1,31 @@
+/**
+ * @file modKeyArg.h
+ * @brief Ключ шифра из аргумента командной строки
+ * @details Общий разбор ключа для cipherTool и cipherFilter
+ * @author Веселов Артем
+ * @version 1.0
+ * @date 15.12.2025
+ */
+
+#pragma once
+#include <string>
+#include <string_view>
+#include "../common/modAlphabet.h"
+
+/**
+ * @brief Преобразование ключа из UTF-8 в wstring
+ * @details Русские буквы переводятся напрямую; прочие символы заменяются
+ * на '?', чтобы ключ не прошел проверку modAlphaCipher
+ * @param [in] s Ключ в UTF-8
+ * @return Ключ в формате wstring
+ */
+inline std::wstring keyFromUtf8(std::string_view s) {
+    std::wstring key;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(s.data());
+    const unsigned char* end = p + s.size();
+    while (p < end) {
+        int i = Alphabet::utf8Next(p, end);
+        key.push_back(i >= 0 ? Alphabet::letter(i) : L'?');
+    }
+    return key;
+}